@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_BENCHMARK_H
+#define UQ_BENCHMARK_H
+
+#include <queso/Environment.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*! \file Benchmark.h
+    \brief Minimal harness for the QUESO microbenchmarks.
+*/
+
+//! State handed to a benchmark function.
+/*! A benchmark does its setup, then times its kernel with
+ * \code
+ *   while (state.keepRunning()) {
+ *     ...
+ *   }
+ * \endcode
+ * The harness chooses the number of iterations so that one repetition
+ * lasts at least the requested minimum time. */
+class BenchmarkState
+{
+public:
+  BenchmarkState(const QUESO::FullEnvironment& env,
+                 unsigned int                  param,
+                 unsigned long                 iterations);
+
+  //! Starts the clock on the first call; false once all iterations are done.
+  bool keepRunning();
+
+  //! Stops the clock, e.g. around per-iteration cleanup that must not be timed.
+  void pauseTiming();
+
+  //! Restarts the clock after pauseTiming().
+  void resumeTiming();
+
+  //! Number of items (chain positions, evaluations, ...) processed per iteration.
+  void setItemsPerIteration(double items);
+
+  //! Size parameter the benchmark was registered with.
+  unsigned int param() const;
+
+  const QUESO::FullEnvironment& env() const;
+
+  //! Iterations left to run; 0 once keepRunning() has returned false.
+  unsigned long remainingIterations() const;
+  double        itemsPerIteration() const;
+
+  //! Timed seconds, once keepRunning() has returned false.
+  double        elapsedSeconds() const;
+
+private:
+  const QUESO::FullEnvironment& m_env;
+  unsigned int                  m_param;
+  unsigned long                 m_remaining;
+  bool                          m_started;
+  bool                          m_running;
+  double                        m_startTime;
+  double                        m_elapsed;
+  double                        m_itemsPerIteration;
+};
+
+//! Signature of a benchmark.
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+//! A benchmark at one value of its size parameter.
+struct BenchmarkCase
+{
+  std::string       name;
+  BenchmarkFunction function;
+  unsigned int      param;
+};
+
+//! All the benchmarks linked into the executable.
+std::vector<BenchmarkCase>& benchmarkRegistry();
+
+//! Registers \c function once for each of the (non-zero) size parameters.
+/*! Meant for file-scope objects, so that adding a benchmark only touches its
+ * own source file. */
+class BenchmarkRegistration
+{
+public:
+  BenchmarkRegistration(const char*       name,
+                        BenchmarkFunction function,
+                        unsigned int      param0,
+                        unsigned int      param1 = 0,
+                        unsigned int      param2 = 0,
+                        unsigned int      param3 = 0);
+};
+
+//! Monotonic wall clock, in seconds from an arbitrary origin.
+double benchmarkSeconds();
+
+//! Keeps the compiler from discarding a computed value.
+void benchmarkDoNotOptimize(double value);
+
+//! Options of runBenchmarks().
+struct BenchmarkRunOptions
+{
+  BenchmarkRunOptions();
+
+  //! Only benchmarks whose name contains this string are run.
+  std::string  filter;
+
+  //! Minimum duration of one repetition, in seconds.
+  double       minTime;
+
+  //! Number of timed repetitions of each benchmark.
+  unsigned int repetitions;
+};
+
+//! Runs the registered benchmarks and writes the results as JSON to \c os.
+/*! Must be called by every process of fullComm(); only process 0 writes. */
+void runBenchmarks(const QUESO::FullEnvironment& env,
+                   const BenchmarkRunOptions&    options,
+                   std::ostream&                 os);
+
+#endif // UQ_BENCHMARK_H
@@ -0,0 +1,75 @@
+"""
+ -----------------------------------------------------------------------bl-
+ --------------------------------------------------------------------------
+
+  QUESO - a library to support the Quantification of Uncertainty
+  for Estimation, Simulation and Optimization
+
+  Copyright (C) 2008-2017 The PECOS Development Team
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the Version 2.1 GNU Lesser General
+  Public License as published by the Free Software Foundation.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc. 51 Franklin Street, Fifth Floor,
+  Boston, MA  02110-1301  USA
+
+-----------------------------------------------------------------------el-
+
+  Compares two result files of queso_bench:
+
+    python compare_bench.py baseline.json candidate.json [threshold]
+
+  For each benchmark present in both files, prints the ratio of the median
+  times (candidate / baseline).  The exit status is 1 if any ratio exceeds
+  1 + threshold (default 0.1, i.e. 10% slower).
+"""
+
+from __future__ import print_function
+
+import json
+import sys
+
+
+def loadResults(fileName):
+    with open(fileName) as f:
+        results = json.load(f)
+    return dict(((b['name'], b['param']), b) for b in results['benchmarks'])
+
+
+def compare(baselineFileName, candidateFileName, threshold=0.1):
+    baseline = loadResults(baselineFileName)
+    candidate = loadResults(candidateFileName)
+
+    regressions = 0
+    print('{0:<60} {1:>12} {2:>12} {3:>8}'.format('benchmark', 'baseline', 'candidate', 'ratio'))
+    for key in sorted(candidate.keys()):
+        if key not in baseline:
+            continue
+        old = baseline[key]['median']
+        new = candidate[key]['median']
+        ratio = new / old if old > 0. else float('inf')
+        flag = ''
+        if ratio > 1. + threshold:
+            flag = ' <-- slower'
+            regressions += 1
+        name = '{0}/{1}'.format(key[0], key[1])
+        print('{0:<60} {1:>12.4g} {2:>12.4g} {3:>8.3f}{4}'.format(name, old, new, ratio, flag))
+
+    return regressions
+
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (3, 4):
+        print(__doc__.split('-el-')[1].strip())
+        sys.exit(2)
+
+    threshold = float(sys.argv[3]) if len(sys.argv) == 4 else 0.1
+    sys.exit(1 if compare(sys.argv[1], sys.argv[2], threshold) else 0)
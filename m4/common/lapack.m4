@@ -0,0 +1,80 @@
+# SYNOPSIS
+#
+#   Test for an optimized LAPACK/BLAS
+#
+#   AX_ENABLE_LAPACK
+#
+# DESCRIPTION
+#
+#   Provides a --with-lapack[=yes|no|LIBS] option (default = no).
+#
+#   With --with-lapack=yes the libraries -lopenblas and then
+#   "-llapack -lblas" are tried in turn; any other value is taken as the
+#   link line to use (e.g. --with-lapack="-L/opt/mkl/lib -lmkl_rt").
+#
+#   On success, sets LAPACK_LIBS, HAVE_LAPACK=1 and #defines HAVE_LAPACK.
+#   LAPACK_LIBS must come before GSL_LIBS on the link line so that the
+#   cblas symbols used by GSL also resolve to the optimized BLAS.
+#
+# LAST MODIFICATION
+#
+#   2017-06-12
+
+AC_DEFUN([AX_ENABLE_LAPACK],
+[
+
+HAVE_LAPACK=0
+LAPACK_LIBS=""
+
+AC_ARG_WITH(lapack,
+  [AS_HELP_STRING([--with-lapack[=yes|no|LIBS]],[route GslMatrix factorizations to an optimized LAPACK/BLAS (default = no)])],
+  [with_lapack=$withval],
+  [with_lapack=no]
+)
+
+if test "x$with_lapack" != "xno" ; then
+
+   AC_LANG_PUSH([C])
+   ac_lapack_save_LIBS="$LIBS"
+
+   if test "x$with_lapack" = "xyes" ; then
+      ac_lapack_candidates="-lopenblas:-llapack -lblas"
+   else
+      ac_lapack_candidates="$with_lapack"
+   fi
+
+   ac_lapack_save_IFS="$IFS"
+   IFS=":"
+   for ac_lapack_try in $ac_lapack_candidates ; do
+      IFS="$ac_lapack_save_IFS"
+      AC_MSG_CHECKING([for dpotrf_ and dsyev_ in $ac_lapack_try])
+      LIBS="$ac_lapack_try $ac_lapack_save_LIBS"
+      AC_LINK_IFELSE([AC_LANG_CALL([], [dpotrf_])],
+        [AC_LINK_IFELSE([AC_LANG_CALL([], [dsyev_])],
+           [LAPACK_LIBS="$ac_lapack_try"])])
+      if test "x$LAPACK_LIBS" != "x" ; then
+         AC_MSG_RESULT([yes])
+         break
+      fi
+      AC_MSG_RESULT([no])
+   done
+   IFS="$ac_lapack_save_IFS"
+
+   LIBS="$ac_lapack_save_LIBS"
+   AC_LANG_POP([C])
+
+   if test "x$LAPACK_LIBS" = "x" ; then
+      AC_MSG_ERROR([--with-lapack was given but no usable LAPACK/BLAS was found])
+   fi
+
+   AC_DEFINE(HAVE_LAPACK,1,[Define if an optimized LAPACK/BLAS is available])
+   HAVE_LAPACK=1
+
+fi
+
+AM_CONDITIONAL(LAPACK_ENABLED, test x$HAVE_LAPACK = x1)
+
+AC_SUBST(LAPACK_LIBS)
+AC_SUBST(HAVE_LAPACK)
+
+])
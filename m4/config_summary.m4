@@ -84,6 +84,12 @@ else
   echo '   'Link with HDF5............. : yes
 fi
 
+if test "$HAVE_LAPACK" = "0"; then
+  echo '   'Link with LAPACK........... : no
+else
+  echo '   'Link with LAPACK........... : yes
+fi
+
 if test "$HAVE_TRILINOS" == "0"; then
   echo '   'Link with Trilinos......... : no
 else
@@ -108,6 +114,12 @@ else
    echo '   'Build internal ANN library. : yes
 fi
 
+if test "x$OPENMP_CXXFLAGS" = "x"; then
+   echo '   'Enable OpenMP.............. : no
+else
+   echo '   'Enable OpenMP.............. : yes
+fi
+
 # Paths for optional packages which are enabled
 
 echo
@@ -0,0 +1,391 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_MAPPED_SEQUENCE_OF_VECTORS_H
+#define UQ_MAPPED_SEQUENCE_OF_VECTORS_H
+
+#include <queso/VectorSequence.h>
+
+#include <cstddef>
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file MappedSequenceOfVectors.h
+ * \brief A templated class for handling vector samples stored in a chain file
+ *
+ * \class MappedSequenceOfVectors
+ * \brief Read-only sequence of vectors backed by a memory-mapped chain file.
+ *
+ * The positions are never copied into vector objects: the chain file is
+ * mapped read-only and positions are decoded from the mapping when they are
+ * needed, so chains much larger than the node memory can be post-processed.
+ * All processes of a node share the page-cache copy of the file.
+ *
+ * The files QUESO writes are read as they are:
+ *  - 'm' and 'txt' files, as written by SequenceOfVectors::subWriteContents()
+ *    and SequenceOfVectors::unifiedWriteContents(), are parsed in place.  One
+ *    sequential scan at construction indexes every
+ *    UQ_MAPPED_SEQUENCE_INDEX_STRIDE-th position, so random access only
+ *    parses a few lines;
+ *  - 'h5' files are mapped directly if their "data" dataset is stored
+ *    contiguously as native doubles, as written by
+ *    SequenceOfVectors::subWriteContents().  Chunked or compressed datasets
+ *    (unified HDF5 chains) cannot be mapped.
+ *
+ * Means, variances, extreme values, autocovariances and histograms are
+ * computed in one sequential sweep over the file for all components, so
+ * kernel readahead works well.  Statistics that need a component in memory
+ * (medians, interquartile ranges, KDE, FFT) extract one component at a time,
+ * exactly like SequenceOfVectors does.
+ *
+ * The values cannot be changed.  Burn-in removal and thinning (erasePositions()
+ * at either end, resizeSequence() to a smaller size, filter()) only change
+ * which positions of the file the sequence refers to. */
+
+template <class V = GslVector, class M = GslMatrix>
+class MappedSequenceOfVectors : public BaseVectorSequence<V,M>
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Maps the chain file \c fileName.fileType.
+  /*! As in SequenceOfVectors::unifiedReadContents(), subenvironment \c s is
+   * given positions [s * subSequenceSize, (s+1) * subSequenceSize) of the
+   * file; \c subSequenceSize = 0 splits the whole chain evenly over the
+   * subenvironments.  A sub chain file is read by passing its full base name,
+   * e.g. "rawChain_sub0". */
+  MappedSequenceOfVectors(const VectorSpace<V,M>& vectorSpace,
+                          const std::string&      fileName,
+                          const std::string&      fileType,
+                          unsigned int            subSequenceSize,
+                          const std::string&      name);
+  //! Destructor; unmaps the file.
+  ~MappedSequenceOfVectors();
+  //@}
+
+  //! @name Sequence methods
+  //@{
+  //! Size of the sub-sequence of vectors.
+  unsigned int subSequenceSize            () const;
+
+  //! Drops the positions from \c newSubSequenceSize on; the sequence cannot grow.
+  /*! This routine deletes all stored computed vectors */
+  void         resizeSequence             (unsigned int newSubSequenceSize);
+
+  //! Not available: the values are read-only.
+  void         resetValues                (unsigned int initialPos, unsigned int numPos);
+
+  //! Erases \c numPos positions at the beginning or at the end of the sequence.
+  /*! This routine deletes all stored computed vectors */
+  void         erasePositions             (unsigned int initialPos, unsigned int numPos);
+
+  //! Gets the values of the sequence at position \c posId and stores them at \c vec.
+  void         getPositionValues          (unsigned int posId,       V& vec) const;
+
+  //! Not available: the values are read-only.
+  void         setPositionValues          (unsigned int posId, const V& vec);
+
+  //! Name of the mapped file.
+  const std::string& fileName             () const;
+
+  //! Finds the mean value of the sub-sequence, considering \c numPos positions starting at position \c initialPos.
+  void         subMeanExtra               (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   meanVec) const;
+  //! Finds the mean value of the unified sequence, considering \c numPos positions starting at position \c initialPos.
+  void         unifiedMeanExtra           (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   unifiedMeanVec) const;
+  //! Finds the median value of the sub-sequence, considering \c numPos positions starting at position \c initialPos.
+  void         subMedianExtra             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   medianVec) const;
+  //! Finds the median value of the unified sequence, considering \c numPos positions starting at position \c initialPos.
+  void         unifiedMedianExtra         (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   unifiedMedianVec) const;
+  //! Finds the sample variance of the sub-sequence, considering \c numPos positions starting at position \c initialPos and of mean \c meanVec.
+  void         subSampleVarianceExtra     (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V&                             meanVec,
+                                           V&                                   samVec) const;
+  //! Finds the sample variance of the unified sequence, considering \c numPos positions starting at position \c initialPos and of mean \c unifiedMeanVec.
+  void         unifiedSampleVarianceExtra (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V&                             unifiedMeanVec,
+                                           V&                                   unifiedSamVec) const;
+  //! Finds the population variance of the sub-sequence, considering \c numPos positions starting at position \c initialPos and of mean \c meanVec.
+  void         subPopulationVariance      (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V&                             meanVec,
+                                           V&                                   popVec) const;
+  //! Finds the population variance of the unified sequence, considering \c numPos positions starting at position \c initialPos and of mean \c unifiedMeanVec.
+  void         unifiedPopulationVariance  (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V&                             unifiedMeanVec,
+                                           V&                                   unifiedPopVec) const;
+  //! Calculates the autocovariance at lag \c lag; the two ends of the lag are read by two sequential sweeps.
+  void         autoCovariance             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V&                             meanVec,
+                                           unsigned int                         lag,
+                                           V&                                   covVec) const;
+  //! Calculates the autocorrelation at lag \c lag via definition.
+  void         autoCorrViaDef             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           unsigned int                         lag,
+                                           V&                                   corrVec) const;
+  //! Calculates the autocorrelation via Fast Fourier transforms (FFT), one component at a time.
+  void         autoCorrViaFft             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const std::vector<unsigned int>&     lags,
+                                           std::vector<V*>&                     corrVecs) const;
+  //! Calculates the sum of the autocorrelations via Fast Fourier transforms (FFT), one component at a time.
+  void         autoCorrViaFft             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           unsigned int                         numSum,
+                                           V&                                   autoCorrsSumVec) const;
+  //! Finds the minimum and the maximum values of the sub-sequence, considering \c numPos positions starting at position \c initialPos.
+  void         subMinMaxExtra             (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   minVec,
+                                           V&                                   maxVec) const;
+  //! Finds the minimum and the maximum values of the unified sequence, considering \c numPos positions starting at position \c initialPos.
+  void         unifiedMinMaxExtra         (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           V&                                   unifiedMinVec,
+                                           V&                                   unifiedMaxVec) const;
+  //! Calculates the histogram of the sub-sequence; see SequenceOfVectors::subHistogram().
+  void         subHistogram               (unsigned int                         initialPos,
+                                           const V&                             minVec,
+                                           const V&                             maxVec,
+                                           std::vector<V*>&                     centersForAllBins,
+                                           std::vector<V*>&                     quanttsForAllBins) const;
+  //! Calculates the histogram of the unified sequence; see SequenceOfVectors::unifiedHistogram().
+  void         unifiedHistogram           (unsigned int                         initialPos,
+                                           const V&                             unifiedMinVec,
+                                           const V&                             unifiedMaxVec,
+                                           std::vector<V*>&                     unifiedCentersForAllBins,
+                                           std::vector<V*>&                     unifiedQuanttsForAllBins) const;
+  //! Returns the interquartile range of the values in the sub-sequence.
+  void         subInterQuantileRange      (unsigned int                         initialPos,
+                                           V&                                   iqrVec) const;
+  //! Returns the interquartile range of the values in the unified sequence.
+  void         unifiedInterQuantileRange  (unsigned int                         initialPos,
+                                           V&                                   unifiedIqrVec) const;
+  //! Selects the scales (bandwidth, \c scaleVec) for the kernel density estimation, considering only the sub-sequence.
+  void         subScalesForKde            (unsigned int                         initialPos,
+                                           const V&                             iqrVec,
+                                           unsigned int                         kdeDimension,
+                                           V&                                   scaleVec) const;
+  //! Selects the scales (bandwidth) for the kernel density estimation, considering the unified sequence.
+  void         unifiedScalesForKde        (unsigned int                         initialPos,
+                                           const V&                             unifiedIqrVec,
+                                           unsigned int                         kdeDimension,
+                                           V&                                   unifiedScaleVec) const;
+  //! Gaussian kernel for the KDE estimate of the sub-sequence.
+  void         subGaussian1dKde           (unsigned int                         initialPos,
+                                           const V&                             scaleVec,
+                                           const std::vector<V*>&               evalParamVecs,
+                                           std::vector<V*>&                     densityVecs) const;
+  //! Gaussian kernel for the KDE estimate of the unified sequence.
+  void         unifiedGaussian1dKde       (unsigned int                         initialPos,
+                                           const V&                             unifiedScaleVec,
+                                           const std::vector<V*>&               unifiedEvalParamVecs,
+                                           std::vector<V*>&                     unifiedDensityVecs) const;
+  //! Writes the sub-sequence to a file; see SequenceOfVectors::subWriteContents().
+  void         subWriteContents           (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const std::string&                   fileName,
+                                           const std::string&                   fileType,
+                                           const std::set<unsigned int>&        allowedSubEnvIds) const;
+  //! Writes the sub-sequence to \c ofs in 'm' or 'txt' format.
+  void         subWriteContents           (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           std::ofstream&                       ofs,
+                                           const std::string&                   fileType) const;
+  //! Writes the unified sequence in 'm' or 'txt' format; 'h5' would need the whole chain in memory.
+  void         unifiedWriteContents       (const std::string&                   fileName,
+                                           const std::string&                   fileType) const;
+  //! Not available: map the file with a new object instead.
+  void         unifiedReadContents        (const std::string&                   fileName,
+                                           const std::string&                   fileType,
+                                           const unsigned int                   subSequenceSize);
+  //! Not available: the values are read-only.
+  void         select                     (const std::vector<unsigned int>&     idsOfUniquePositions);
+
+  //! Keeps the positions starting at \c initialPos, with spacing \c spacing; nothing is copied.
+  /*! This routine deletes all stored computed vectors */
+  void         filter                     (unsigned int                         initialPos,
+                                           unsigned int                         spacing);
+
+  //! Estimates convergence rate using Brooks & Gelman method.
+  double       estimateConvBrooksGelman   (unsigned int                         initialPos,
+                                           unsigned int                         numPos) const;
+
+  //! Extracts a sequence of scalars in one sweep over the file.
+  void         extractScalarSeq           (unsigned int                         initialPos,
+                                           unsigned int                         spacing,
+                                           unsigned int                         numPos,
+                                           unsigned int                         paramId,
+                                           ScalarSequence<double>&              scalarSeq) const;
+
+#ifdef QUESO_COMPUTES_EXTRA_POST_PROCESSING_STATISTICS
+  void         subUniformlySampledCdf     (const V&                             numEvaluationPointsVec,
+                                           ArrayOfOneDGrids <V,M>&              cdfGrids,
+                                           ArrayOfOneDTables<V,M>&              cdfValues) const;
+  void         unifiedUniformlySampledCdf (const V&                             numEvaluationPointsVec,
+                                           ArrayOfOneDGrids <V,M>&              unifiedCdfGrids,
+                                           ArrayOfOneDTables<V,M>&              unifiedCdfValues) const;
+  void         bmm                        (unsigned int                         initialPos,
+                                           unsigned int                         batchLength,
+                                           V&                                   bmmVec) const;
+  void         fftForward                 (unsigned int                         initialPos,
+                                           unsigned int                         fftSize,
+                                           unsigned int                         paramId,
+                                           std::vector<std::complex<double> >&  fftResult) const;
+  void         psd                        (unsigned int                         initialPos,
+                                           unsigned int                         numBlocks,
+                                           double                               hopSizeRatio,
+                                           unsigned int                         paramId,
+                                           std::vector<double>&                 psdResult) const;
+  void         psdAtZero                  (unsigned int                         initialPos,
+                                           unsigned int                         numBlocks,
+                                           double                               hopSizeRatio,
+                                           V&                                   psdVec) const;
+  void         geweke                     (unsigned int                         initialPos,
+                                           double                               ratioNa,
+                                           double                               ratioNb,
+                                           V&                                   gewVec) const;
+  void         meanStacc                  (unsigned int                         initialPos,
+                                           V&                                   meanStaccVec) const;
+  void         subCdfStacc                (unsigned int                         initialPos,
+                                           const std::vector<V*>&               evalPositionsVecs,
+                                           std::vector<V*>&                     cdfStaccVecs) const;
+#endif
+
+#ifdef UQ_ALSO_COMPUTE_MDFS_WITHOUT_KDE
+  void         subUniformlySampledMdf     (const V&                             numEvaluationPointsVec,
+                                           ArrayOfOneDGrids <V,M>&              mdfGrids,
+                                           ArrayOfOneDTables<V,M>&              mdfValues) const;
+#endif
+  //@}
+
+private:
+  //! Read position in the mapped file.
+  /*! Every sweep owns its cursors, so const methods may run concurrently
+   * (BaseVectorSequence::subChainStatistics() extracts components in
+   * parallel OpenMP threads). */
+  struct Cursor
+  {
+    Cursor() : line(0), offset(0) {}
+
+    //! Position in the file (not in the sequence) of the line at \c offset.
+    unsigned int line;
+    std::size_t  offset;
+  };
+
+  //! Not available: the object owns the mapping.
+  MappedSequenceOfVectors(const MappedSequenceOfVectors<V,M>& rhs);
+  MappedSequenceOfVectors<V,M>& operator= (const MappedSequenceOfVectors<V,M>& rhs);
+
+  //! Extracts the raw data in one sweep over the file.
+  void         extractRawData             (unsigned int                         initialPos,
+                                           unsigned int                         spacing,
+                                           unsigned int                         numPos,
+                                           unsigned int                         paramId,
+                                           std::vector<double>&                 rawData) const;
+
+  //! Maps the whole file read-only.
+  void         mapFile                    (const std::string&                   fullFileName);
+
+  //! Parses the header of an 'm' or 'txt' file and indexes its positions.
+  void         indexTextFile              (const std::string&                   fileType);
+
+  //! Finds the contiguous "data" dataset of an 'h5' file.
+  void         locateHdf5Data             (const std::string&                   fullFileName);
+
+  //! Offset of the line following the one at \c offset.
+  std::size_t  nextLine                   (std::size_t                          offset) const;
+
+  //! Decodes the first \c numValues values of position \c posId of the sequence.
+  /*! \c cursor is moved past the position, so that reading the following
+   * positions in order only moves forward through the file. */
+  void         readPosition               (unsigned int                         posId,
+                                           unsigned int                         numValues,
+                                           Cursor&                              cursor,
+                                           double*                              values) const;
+
+  //! Sums of the values (\c centerVec == NULL) or of their squared deviations from \c centerVec.
+  void         subSums                    (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V*                             centerVec,
+                                           std::vector<double>&                 sums) const;
+
+  //! subSums() added over inter0Comm; also returns the unified number of positions.
+  void         unifiedSums                (unsigned int                         initialPos,
+                                           unsigned int                         numPos,
+                                           const V*                             centerVec,
+                                           std::vector<double>&                 unifiedSums,
+                                           unsigned int&                        unifiedNumPos) const;
+
+  //! Bin counts of every component, as in ScalarSequence::subHistogram().
+  void         subBinCounts               (unsigned int                         initialPos,
+                                           const V&                             minVec,
+                                           const V&                             maxVec,
+                                           unsigned int                         numBins,
+                                           std::vector<unsigned int>&           counts) const;
+
+  using BaseVectorSequence<V,M>::m_env;
+  using BaseVectorSequence<V,M>::m_vectorSpace;
+  using BaseVectorSequence<V,M>::m_name;
+  using BaseVectorSequence<V,M>::m_fftObj;
+
+  std::string              m_fileName;
+  const char*              m_mapped;
+  std::size_t              m_mappedSize;
+
+  //! Positions are parsed ('m' and 'txt') or copied ('h5') from the mapping.
+  bool                     m_isText;
+
+  //! 'h5': offset of the first value.
+  std::size_t              m_dataOffset;
+
+  //! 'm' and 'txt': offset of every UQ_MAPPED_SEQUENCE_INDEX_STRIDE-th position of the file.
+  std::vector<std::size_t> m_lineIndex;
+
+  unsigned int             m_numPositionsInFile;
+
+  //! Position k of the sequence is position m_firstPos + k * m_spacing of the file.
+  unsigned int             m_firstPos;
+  unsigned int             m_spacing;
+  unsigned int             m_subSequenceSize;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_MAPPED_SEQUENCE_OF_VECTORS_H
@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_QUANTILE_SKETCH_H
+#define UQ_QUANTILE_SKETCH_H
+
+#include <queso/MpiComm.h>
+
+#include <vector>
+
+//! Default accuracy parameter k of QuantileSketch; the rank error is roughly 1.7 / k.
+#define UQ_QUANTILE_SKETCH_K_ODV 200
+
+namespace QUESO {
+
+/*! \file QuantileSketch.h
+    \brief Mergeable approximate quantiles of a stream of scalars
+*/
+
+/*! \class QuantileSketch
+ *  \brief KLL sketch of Karnin, Lang and Liberty.
+ *
+ * Values go into a stack of compactors.  Compactor h holds values of weight
+ * 2^h; when it is full it is sorted and every other value, starting at a
+ * random offset, is promoted to compactor h+1.  Compactor capacities shrink
+ * geometrically (by 2/3) from the top one, which holds k values, so the
+ * sketch keeps O(k) values whatever the number of insertions, and a
+ * quantile has rank error about 1.7 / k with high probability.
+ *
+ * Two sketches of the same k merge by concatenating their compactors, so
+ * per-process sketches can be combined in any order; unifiedReduce() does
+ * so over a communicator.  The exact minimum and maximum are also kept.
+ */
+class QuantileSketch
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor; \c k (at least 8) sets the size and the accuracy.
+  QuantileSketch(unsigned int k = UQ_QUANTILE_SKETCH_K_ODV);
+
+  //! Destructor.
+  ~QuantileSketch();
+  //@}
+
+  //! @name Accumulation methods
+  //@{
+  //! Adds one value.
+  void insert(double value);
+
+  //! Adds all the values summarised by \c other, which must have the same k.
+  void merge(const QuantileSketch & other);
+
+  //! Merges the sketches of all processes of \c comm; all of them get the result.
+  void unifiedReduce(const MpiComm & comm);
+
+  //! Forgets all values.
+  void clear();
+  //@}
+
+  //! @name Query methods
+  //@{
+  //! Number of values inserted (including merged ones).
+  double count() const;
+
+  //! Exact smallest value.
+  double minValue() const;
+
+  //! Exact largest value.
+  double maxValue() const;
+
+  //! Approximate value below which a fraction \c fraction of the values lie.
+  double quantile(double fraction) const;
+
+  //! Approximate fraction of the values less than or equal to \c value.
+  double cdf(double value) const;
+
+  //! Number of values currently kept.
+  unsigned int numRetained() const;
+  //@}
+
+  //! @name Serialization methods
+  //@{
+  //! Appends the sketch to \c buffer.
+  void pack(std::vector<double> & buffer) const;
+
+  //! Replaces the sketch by the one packed in \c buffer at \c offset; advances \c offset.
+  void unpack(const std::vector<double> & buffer, unsigned int & offset);
+  //@}
+
+private:
+  //! Capacity of compactor \c level.
+  unsigned int capacity(unsigned int level) const;
+
+  //! Compacts full compactors until the sketch fits its total capacity.
+  void compress();
+
+  //! Sorted values with their weights, for queries.
+  void weightedValues(std::vector<std::pair<double, double> > & values) const;
+
+  //! Random bit for the compaction offsets (xorshift).
+  unsigned int randomBit();
+
+  unsigned int m_k;
+  std::vector<std::vector<double> > m_compactors;
+  unsigned int m_numRetained;
+  double m_count;
+  double m_min;
+  double m_max;
+  unsigned int m_randomState;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_QUANTILE_SKETCH_H
@@ -81,6 +81,14 @@ public:
   double callFunction(const V* vecValues,
                       double* extraOutput1,
                       double* extraOutput2) const;
+
+  //! Calls the scalar function on the calling process only.
+  /*! No other process takes part, so the function must be evaluable by a
+   * single process.  Used by samplers that spread independent evaluations
+   * over the processes of a subenvironment. */
+  double callFunctionLocally(const V& vecValues,
+                             double* extraOutput1,
+                             double* extraOutput2) const;
   //@}
 private:
   const BaseEnvironment&         m_env;
@@ -30,6 +30,7 @@
 #include <queso/Environment.h>
 #include <queso/Miscellaneous.h>
 #include <queso/Defines.h>
+#include <queso/QuantileSketch.h>
 #include <vector>
 #include <complex>
 #include <sys/time.h>
@@ -73,6 +74,15 @@ public:
   //@{
   //! Assignment operator; it copies \c rhs to \c this.
   ScalarSequence<T>& operator= (const ScalarSequence<T>& rhs);
+
+  //! Sets the accuracy parameter k of the sketch used for unified quantiles.
+  /*! With 0 (the default) unifiedMedianExtra(), unifiedInterQuantileRange() and
+   * unifiedCdfPercentageRange() gather and sort all the samples of all
+   * subenvironments (see unifiedSort()).  With k > 0 every subenvironment
+   * summarises its samples in a QuantileSketch of parameter k, and only the
+   * sketches, O(k) values each, are merged over inter0Comm; the rank error
+   * of the results is then about 1.7 / k. */
+  void setUnifiedQuantileSketchSize(unsigned int sketchSize);
   //@}
 
   //! @name Access methods
@@ -93,6 +103,9 @@ public:
   //! Access to the name of the sequence of scalars.
   const std::string& name                         () const;
 
+  //! Accuracy parameter of the sketch used for unified quantiles; 0 means exact.
+  unsigned int unifiedQuantileSketchSize    () const;
+
   //! Sets a new name to the sequence of scalars.
   void         setName                      (const std::string& newName);
 
@@ -428,6 +441,11 @@ public:
 					     unsigned int                    numPos,
 					     std::ofstream&                  ofs,
 					     const std::string&              fileType) const;
+  //! Writes the header subWriteContents() writes for a sub-sequence of \c sequenceSize positions.
+  /*! Lets a caller stream the values to \c ofs one line at a time, ending a Matlab file with "];". */
+  void         subWriteHeader               (std::ofstream&                  ofs,
+					     unsigned int                    sequenceSize,
+					     const std::string&              fileType) const;
   //! Writes the unified sequence to a file.
   /*! Writes the unified sequence in Matlab/Octave format or, if enabled, in HDF5 format.*/
   void         unifiedWriteContents         (const std::string&              fileName,
@@ -486,6 +504,11 @@ private:
   /*! This routine deletes all stored computed scalars. */
   void         copy                         (const ScalarSequence<T>& src);
 
+  //! Sketches \c numPos positions starting at \c initialPos and merges \c sketch over inter0Comm.
+  void         unifiedQuantileSketch        (unsigned int                    initialPos,
+                                             unsigned int                    numPos,
+                                             QuantileSketch&                 sketch) const;
+
   //! Helper function to write header info for matlab files from all chains
   void writeUnifiedMatlabHeader(std::ofstream & ofs, double sequenceSize) const;
 
@@ -525,6 +548,7 @@ private:
   const BaseEnvironment& m_env;
   std::string                   m_name;
   std::vector<T>                m_seq;
+  unsigned int                  m_unifiedQuantileSketchSize;
 
   mutable T*                    m_subMinPlain;
   mutable T*                    m_unifiedMinPlain;
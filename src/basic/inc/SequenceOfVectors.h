@@ -304,6 +304,11 @@ public:
                                            unsigned int                         numPos,
                                            std::ofstream&                       ofs,
                                            const std::string&                   fileType) const;
+  //! Writes the header subWriteContents() writes for a sub-sequence of \c sequenceSize positions.
+  /*! Lets a caller stream the positions to \c ofs one line at a time, ending a Matlab file with "];". */
+  void         subWriteHeader             (std::ofstream&                       ofs,
+                                           unsigned int                         sequenceSize,
+                                           const std::string&                   fileType) const;
   //! Writes the unfed sequence to a file.
   //! Writes the unified sequence in Matlab/Octave format or, if enabled, in HDF5 format.
   void         unifiedWriteContents       (const std::string&                   fileName,
@@ -36,12 +36,47 @@
 #include <queso/2dArrayOfStuff.h>
 #include <sys/time.h>
 #include <fstream>
+#include <map>
+
+//! Number of positions copied into a contiguous block by ComputeCovCorrMatricesBetweenVectorSequences().
+#define UQ_COV_CORR_BLOCK_SIZE 64
 
 namespace QUESO {
 
 class GslVector;
 class GslMatrix;
 
+//! Per-component statistics of a subchain, see BaseVectorSequence::subChainStatistics().
+/*! Entry i of every vector refers to component i of the sequence. */
+struct SubChainStatistics
+{
+  SubChainStatistics()
+    : numPos(0),
+      hasOrderStatistics(false),
+      maxLag(0)
+  {}
+
+  //! Number of positions of the subchain.
+  unsigned int numPos;
+
+  //! Moments and extreme values; always available.
+  std::vector<double> mean;
+  std::vector<double> sampleVariance;
+  std::vector<double> populationVariance;
+  std::vector<double> minValue;
+  std::vector<double> maxValue;
+
+  //! Median and interquartile range; available if \c hasOrderStatistics.
+  bool                hasOrderStatistics;
+  std::vector<double> median;
+  std::vector<double> iqr;
+
+  //! Autocorrelations (via fft) at lags 0, ..., maxLag, and their sum over all lags; available if maxLag > 0.
+  unsigned int                      maxLag;
+  std::vector<std::vector<double> > autoCorrs;
+  std::vector<double>               autoCorrsSum;
+};
+
 /*! \file VectorSequence.h
  * \brief A templated class for handling vector and arrays samples
  *
@@ -92,6 +127,13 @@ public:
   //! Changes the name of the sequence of vectors.
   void                     setName                     (const std::string& newName);
 
+  //! Accuracy parameter of the sketch used for the unified medians, IQRs and cdf percentage ranges.
+  /*! See ScalarSequence::setUnifiedQuantileSketchSize(); 0 (the default) means exact. */
+  void                     setUnifiedQuantileSketchSize(unsigned int sketchSize);
+
+  //! Accuracy parameter of the sketch used for unified quantiles; 0 means exact.
+  unsigned int             unifiedQuantileSketchSize   () const;
+
   //! Reset the values and the size of the sequence of vectors.
   void                     clear                       ();
 
@@ -131,11 +173,23 @@ public:
   //! Finds a box subset of the unified-sequence (given  by the min and max values of the unified sequence calculated via unifiedMinPlain and unifiedMaxPlain).
   const    BoxSubset<V,M>&   unifiedBoxPlain    () const;
 
+  //! Statistics of every component of the subchain starting at position \c initialPos.
+  /*! Each component is extracted once and all the requested statistics are
+   * computed from that copy: the moments and extreme values always, the
+   * median and interquartile range if \c orderStatistics is true, and the
+   * autocorrelations (via fft, one transform per component) if \c maxLag > 0.
+   * Components are processed in parallel OpenMP threads.  The results are
+   * cached on the sequence, so later calls only compute what is missing, until
+   * the sequence changes (see deleteStoredVectors()). */
+  const    SubChainStatistics& subChainStatistics      (unsigned int initialPos,
+                                                        unsigned int maxLag,
+                                                        bool         orderStatistics) const;
+
   //! Deletes all the stored vectors.
   /*! It deletes all stored vectors and assigns NULL value to the pointers: m_subMinPlain,
    * m_unifiedMinPlain, m_subMaxPlain, m_unifiedMaxPlain, m_subMeanPlain, m_unifiedMeanPlain,
    * m_subMedianPlain, m_unifiedMedianPlain, m_subBoxPlain, m_unifiedBoxPlain,
-   * m_subSampleVariancePlain, m_unifiedSampleVariancePlain. */
+   * m_subSampleVariancePlain, m_unifiedSampleVariancePlain, and the cached subChainStatistics(). */
   void                     deleteStoredVectors         ();
 
   //! Appends the vector \c src to \c this vector.
@@ -425,6 +479,7 @@ protected:
   const BaseEnvironment&  m_env;
   const VectorSpace<V,M>& m_vectorSpace;
   std::string                    m_name;
+  unsigned int                   m_unifiedQuantileSketchSize;
 
   mutable Fft<double>*    m_fftObj;
   mutable V*                     m_subMinPlain;
@@ -440,6 +495,9 @@ protected:
   mutable BoxSubset<V,M>* m_subBoxPlain;
   mutable BoxSubset<V,M>* m_unifiedBoxPlain;
 
+  // Cached subChainStatistics(), by initial position
+  mutable std::map<unsigned int, SubChainStatistics> m_subChainStatistics;
+
 
 #ifdef UQ_CODE_HAS_MONITORS
   virtual  void           subMeanMonitorAlloc         (unsigned int numberOfMonitorPositions) = 0;
@@ -533,6 +591,13 @@ protected:
 // Additional methods --------------------------------
 // (outside class declaration) ----------------------
 //---------------------------------------------------
+//! Unified covariance and correlation matrices between the first \c subNumSamples positions of two sequences.
+/*! The sequences are read once, UQ_COV_CORR_BLOCK_SIZE positions at a time, and
+ * the cross products of each block are accumulated row by row over the OpenMP
+ * threads (only the upper triangle if \c subPSeq and \c subQSeq are the same
+ * object).  A single Allreduce over inter0Comm combines the subenvironments.
+ * The unified means and sample variances, which come out of the same pass, are
+ * returned through the optional vectors. */
 template <class P_V, class P_M, class Q_V, class Q_M>
 void
 ComputeCovCorrMatricesBetweenVectorSequences(
@@ -540,7 +605,11 @@ ComputeCovCorrMatricesBetweenVectorSequences(
   const BaseVectorSequence<Q_V,Q_M>& subQSeq,
         unsigned int                        subNumSamples,
         P_M&                                pqCovMatrix,
-        P_M&                                pqCorrMatrix);
+        P_M&                                pqCorrMatrix,
+        P_V*                                unifiedMeanP = NULL,
+        P_V*                                unifiedSampleVarianceP = NULL,
+        Q_V*                                unifiedMeanQ = NULL,
+        Q_V*                                unifiedSampleVarianceQ = NULL);
 
 }  // End namespace QUESO
 
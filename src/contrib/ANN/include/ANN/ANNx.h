@@ -58,6 +58,10 @@ enum ANNerr {ANNwarn = 0, ANNabort = 1};
 extern int		ANNmaxPtsVisited;	// maximum number of pts visited
 extern int		ANNptsVisited;		// number of pts visited in search
 
+#ifdef _OPENMP
+#pragma omp threadprivate(ANNptsVisited)
+#endif
+
 //----------------------------------------------------------------------
 //	Global function declarations
 //----------------------------------------------------------------------
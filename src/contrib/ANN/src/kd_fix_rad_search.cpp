@@ -51,6 +51,11 @@ ANNmin_k*		ANNkdFRPointMK;			// set of k closest points
 int				ANNkdFRPtsVisited;		// total points visited
 int				ANNkdFRPtsInRange;		// number of points in the range
 
+#ifdef _OPENMP
+#pragma omp threadprivate(ANNkdFRDim, ANNkdFRQ, ANNkdFRSqRad, ANNkdFRMaxErr, \
+	ANNkdFRPts, ANNkdFRPointMK, ANNkdFRPtsVisited, ANNkdFRPtsInRange)
+#endif
+
 //----------------------------------------------------------------------
 //	annkFRSearch - fixed radius search for k nearest neighbors
 //----------------------------------------------------------------------
@@ -41,4 +41,8 @@
 
 extern ANNpoint			ANNkdFRQ;			// query point (static copy)
 
+#ifdef _OPENMP
+#pragma omp threadprivate(ANNkdFRQ)
+#endif
+
 #endif
@@ -45,4 +45,9 @@ extern ANNpointArray	ANNkdPts;		// the points (static copy)
 extern ANNmin_k			*ANNkdPointMK;	// set of k closest points
 extern int				ANNptsVisited;	// number of points visited
 
+// Per-thread copies, so that concurrent queries on one tree do not race.
+#ifdef _OPENMP
+#pragma omp threadprivate(ANNkdDim, ANNkdQ, ANNkdMaxErr, ANNkdPts, ANNkdPointMK, ANNptsVisited)
+#endif
+
 #endif
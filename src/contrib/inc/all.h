@@ -52,6 +52,11 @@
 #include<queso/BetaVectorRealizer.h>
 #include<queso/VectorMdf.h>
 #include<queso/StatisticalForwardProblemOptions.h>
+#include<queso/ExperimentalDesign.h>
+#include<queso/StreamingConvergenceMonitor.h>
+#include<queso/ParallelTemperingSG.h>
+#include<queso/EnsembleSamplerSG.h>
+#include<queso/OnlineVectorStatistics.h>
 #include<queso/ValidationCycle.h>
 #include<queso/PoweredJointPdf.h>
 #include<queso/GaussianVectorMdf.h>
@@ -110,6 +115,7 @@
 #include<queso/SurrogateBase.h>
 #include<queso/SurrogateBuilderBase.h>
 #include<queso/InterpolationSurrogateIOASCII.h>
+#include<queso/InterpolationSurrogateIOBinary.h>
 #include<queso/InterpolationSurrogateBase.h>
 #include<queso/InterpolationSurrogateDataSet.h>
 #include<queso/InterpolationSurrogateBuilder.h>
@@ -154,6 +160,7 @@
 #include<queso/RngGsl.h>
 #include<queso/LibMeshFunction.h>
 #include<queso/MpiComm.h>
+#include<queso/Instrumentation.h>
 #include<queso/Optimizer.h>
 #include<queso/RngBase.h>
 #include<queso/EnvironmentOptions.h>
@@ -195,11 +202,13 @@
 #include<queso/VectorFunction.h>
 #include<queso/InstantiateIntersection.h>
 #include<queso/SequenceOfVectors.h>
+#include<queso/MappedSequenceOfVectors.h>
 #include<queso/BoxSubset.h>
 #include<queso/GenericScalarFunction.h>
 #include<queso/SequenceStatisticalOptions.h>
 #include<queso/ConcatenationSubset.h>
 #include<queso/ScalarSequence.h>
+#include<queso/QuantileSketch.h>
 #include<queso/ScalarFunctionSynchronizer.h>
 #include<queso/GenericVectorFunction.h>
 #include<queso/VectorSpace.h>
@@ -36,6 +36,10 @@
 #define QUESO_HAS_HDF5
 #endif
 
+#ifdef QUESO_HAVE_LAPACK
+#define QUESO_HAS_LAPACK
+#endif
+
 #ifdef QUESO_HAVE_TRILINOS
 #define QUESO_HAS_TRILINOS
 #endif
@@ -103,6 +107,11 @@ const int UQ_MATRIX_SVD_FAILED_RC          = -11;
 #define UQ_FILE_EXTENSION_FOR_TXT_FORMAT    "txt"
 #define UQ_FILE_EXTENSION_FOR_HDF_FORMAT    "h5"
 
+// Compression level of unified HDF5 chain datasets (0 disables the filter)
+// and target size in bytes of one chunk
+#define UQ_HDF5_DEFLATE_LEVEL 1
+#define UQ_HDF5_CHUNK_BYTES   (1024*1024)
+
 
 /*! \file Defines.h
     \brief Definitions and a class to provide default options to  pass to a QUESO environment.
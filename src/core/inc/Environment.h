@@ -33,6 +33,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #ifndef QUESO_DISABLE_BOOST_PROGRAM_OPTIONS
 // Forward declarations
@@ -409,6 +410,27 @@ public:
   //! Closes the file.
   void    closeFile     (FilePtrSetStruct& filePtrSet, const std::string& fileType) const;
 
+#ifdef QUESO_HAS_HDF5
+  //! Writes the chain of each inter0 rank r to dataset "sub_<r>" of a unified HDF5 file.
+  /*!
+   * Must be called by all processes of inter0Comm().  \c localValues holds
+   * \c numLocalRows rows of \c numCols values each, row-major; the chains may
+   * have different lengths.  \c dataRank is 1 for scalar sequences (a 1-D
+   * dataset per chain, \c numCols must be 1) and 2 for vector sequences.
+   *
+   * The datasets are chunked and, when the deflate filter is available,
+   * compressed with level UQ_HDF5_DEFLATE_LEVEL.  If HDF5 was built with
+   * parallel (MPI-IO) support, every inter0 rank writes its own chain
+   * straight to the shared file; otherwise the chains are gathered on inter0
+   * rank 0, which writes them.
+   */
+  void    writeUnifiedHdf5Chains(const std::string& baseFileName,
+                                 const std::vector<double>& localValues,
+                                 unsigned int numLocalRows,
+                                 unsigned int numCols,
+                                 unsigned int dataRank) const;
+#endif
+
   //! Set an exceptional circumstance.
   void    setExceptionalCircumstance    (bool value) const;
 
@@ -55,6 +55,8 @@
 #define UQ_ENV_PLATFORM_NAME_ODV            ""
 #define UQ_ENV_NUM_DEBUG_PARAMS_ODV         0
 #define UQ_ENV_DEBUG_PARAM_ODV              0.
+#define UQ_ENV_INSTRUMENTATION_FILE_NAME_ODV UQ_ENV_FILENAME_FOR_NO_OUTPUT_FILE
+#define UQ_ENV_INSTRUMENTATION_PERIOD_ODV    0.
 
 #ifndef QUESO_DISABLE_BOOST_PROGRAM_OPTIONS
 // Forward declarations
@@ -177,6 +179,12 @@ public:
 
   //! Debug parameters.  Unused?
   std::vector<double> m_debugParams;
+
+  //! Base name of the JSON timing and counter report; enables Instrumentation.
+  std::string m_instrumentationFileName;
+
+  //! Seconds between the per-process instrumentation snapshots; 0 for none.
+  double m_instrumentationPeriod;
   //@}
 
 private:
@@ -225,6 +233,12 @@ private:
   //! Input file option name for m_identifyingString
   std::string m_option_identifyingString;
 
+  //! Input file option name for m_instrumentationFileName
+  std::string m_option_instrumentationFileName;
+
+  //! Input file option name for m_instrumentationPeriod
+  std::string m_option_instrumentationPeriod;
+
   //! Makes an exact copy of an existing EnvOptionsValues instance.
   void copy(const EnvOptionsValues& src);
 
@@ -218,6 +218,10 @@ public:
   //the preallocated vector \c y.
   void       multiply                  (const GslVector& x, GslVector& y) const;
 
+  //! This function computes \c y = \c alpha * \c this * \c x + \c beta * \c y in place (BLAS gemv).
+  /*! No temporaries are allocated; \c y must be preallocated and must not alias \c x. */
+  void       multiplyAdd               (double alpha, const GslVector& x, double beta, GslVector& y) const;
+
   //! This function multiplies \c this matrix by matrix \c X and returns the resulting matrix.
   GslMatrix  multiply                  (const GslMatrix& X) const;
 
@@ -303,6 +307,10 @@ GslVector& x) internally.*/
   if \c includeDiagonal = true, then the elements of the matrix diagonal are also set to zero.*/
   void              zeroUpper                 (bool includeDiagonal = false);
 
+  //! This function adds \c alpha * \c x * \c x^T to \c this matrix in place (BLAS syr).
+  /*! \c this is assumed symmetric; both triangles are updated. */
+  void              symmetricRankOneUpdate    (double alpha, const GslVector& x);
+
   //! This function sets to zero (filters) all entries of \c this matrix which are smaller than \c thresholdValue.
   /*! If \c thresholdValue < 0 then no values will be filtered.*/
   void              filterSmallValues         (double thresholdValue);
@@ -475,6 +483,11 @@ private:
    * A is the square matrix of interest and P is the permutation matrix.     */
   mutable gsl_permutation*  m_permutation;
 
+  //! Row interchanges of the LU decomposition when QUESO is built with LAPACK.
+  /*! LAPACK factors the transpose of the (row-major) matrix, so these pivots
+   * take the place of m_permutation in that build. */
+  mutable std::vector<int>  m_pivots;
+
   //! m_signum stores the sign of the permutation of the LU decomposition PA = LU.
   /*! In the  LU decomposition PA = LU, where A is the square matrix of interest
    * and P is the permutation matrix, m_signum has the value (-1)^n,
@@ -171,6 +171,9 @@ public:
   //! This function sets the values of this starting at position initialPos ans saves them in vector vec.
   void         cwExtract        (unsigned int initialPos, GslVector& vec) const;
 
+  //! This function adds \c a times \c x to \c this (BLAS axpy), without temporaries.
+  void         axpy             (double a, const GslVector& x);
+
   //! This function inverts component-wise the element values of \c this.
   void         cwInvert         ();
 
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_INSTRUMENTATION_H
+#define UQ_INSTRUMENTATION_H
+
+#include <string>
+#include <ostream>
+
+// Latency histograms: bucket 0 holds calls under 1 microsecond, bucket b > 0
+// calls in [2^(b-1), 2^b) microseconds, and the last bucket everything longer
+#define UQ_INSTRUMENTATION_NUM_BUCKETS 32
+
+namespace QUESO {
+
+class BaseEnvironment;
+
+/*! \file Instrumentation.h
+    \brief Process-wide registry of timings and counters of the QUESO hot paths.
+*/
+
+/*! \class Instrumentation
+ *  \brief Timers, counters and latency histograms keyed by region name.
+ *
+ *  The registry is disabled by default, in which case a ScopedTimer costs one
+ *  branch.  It is enabled by the environment when the option
+ *  'env_instrumentationFileName' is set: the statistical inverse and forward
+ *  problems then call write() at the end of every solve, which aggregates
+ *  the registry over the full communicator (min/mean/max over processes) and
+ *  writes it as JSON to <fileName>.json.  If 'env_instrumentationPeriod' is
+ *  positive, every process also rewrites a snapshot of its own registry to
+ *  <fileName>_rank<fullRank>.json at least that many seconds apart.
+ *
+ *  Recording is thread-safe under OpenMP.
+ */
+class Instrumentation
+{
+public:
+  //! Enables the registry; \c period <= 0 disables the periodic snapshots.
+  static void   configure   (const std::string& fileName, double period, int fullRank);
+
+  //! Enables or disables recording without touching the output settings.
+  static void   setEnabled  (bool value);
+
+  static bool   enabled     () { return m_enabled; }
+
+  //! Monotonic wall clock, in seconds from an arbitrary origin.
+  static double seconds     ();
+
+  //! Records one call of \c region lasting \c elapsedSeconds.
+  static void   addTime     (const std::string& region, double elapsedSeconds);
+
+  //! Adds \c amount to \c counter.
+  static void   increment   (const std::string& counter, double amount = 1.);
+
+  //! Forgets every timer and counter.
+  static void   reset       ();
+
+  //! Aggregates over env.fullComm() and writes the JSON to \c fileName on full rank 0.
+  /*! Collective: must be called by every process of env.fullComm(). */
+  static void   writeJson   (const BaseEnvironment& env, const std::string& fileName);
+
+  //! writeJson() to the configured <fileName>.json; does nothing if disabled.
+  static void   write       (const BaseEnvironment& env);
+
+  //! Writes the JSON of this process alone, without communication.
+  static void   writeLocalJson(std::ostream& os);
+
+private:
+  static bool m_enabled;
+};
+
+/*! \class ScopedTimer
+ *  \brief Times the enclosing scope into the Instrumentation registry.
+ *
+ *  \c region must outlive the timer; string literals are the intended use.
+ */
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(const char* region);
+  ~ScopedTimer();
+
+  //! Records the time elapsed so far and stops the timer.
+  void stop();
+
+private:
+  const char* m_region;
+  double      m_start;
+  bool        m_running;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_INSTRUMENTATION_H
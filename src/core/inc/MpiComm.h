@@ -44,6 +44,7 @@ typedef MPI_Datatype RawType_MPI_Datatype ;
 typedef MPI_Datatype data_type ;
 typedef MPI_Op       RawType_MPI_Op ;
 typedef MPI_Status   RawType_MPI_Status ;
+typedef MPI_Request  RawType_MPI_Request ;
 #define RawValue_MPI_COMM_SELF  MPI_COMM_SELF
 #define RawValue_MPI_ANY_SOURCE MPI_ANY_SOURCE
 #define RawValue_MPI_CHAR       MPI_CHAR
@@ -53,6 +54,7 @@ typedef MPI_Status   RawType_MPI_Status ;
 #define RawValue_MPI_MIN        MPI_MIN
 #define RawValue_MPI_MAX        MPI_MAX
 #define RawValue_MPI_SUM        MPI_SUM
+#define RawValue_MPI_REQUEST_NULL MPI_REQUEST_NULL
 #else
 typedef int RawType_MPI_Comm;
 typedef int RawType_MPI_Group;
@@ -60,6 +62,7 @@ typedef int RawType_MPI_Datatype;
 struct data_type { };
 typedef int RawType_MPI_Op;
 typedef int RawType_MPI_Status;
+typedef int RawType_MPI_Request;
 #define RawValue_MPI_COMM_SELF   0
 #define RawValue_MPI_ANY_SOURCE -1
 #define RawValue_MPI_CHAR        0
@@ -69,6 +72,7 @@ typedef int RawType_MPI_Status;
 #define RawValue_MPI_MIN         0
 #define RawValue_MPI_MAX         1
 #define RawValue_MPI_SUM         2
+#define RawValue_MPI_REQUEST_NULL 0
 #endif
 
 /**
@@ -279,6 +283,31 @@ public:
   void Allreduce(const T * sendbuf, T * recvbuf, int count, RawType_MPI_Op op,
                  const char* whereMsg, const char* whatMsg) const;
 
+  //! Starts a nonblocking Allreduce; complete it with Test() or Wait().
+  /*!
+   * \param sendbuf starting address of send buffer containing elements of type T
+   * \param count number of elements in send buffer
+   * \param op operation
+   * \param recvbuf (output) starting address of receive buffer containing elements of type T
+   * \param request (output) handle identifying the pending reduction
+   *
+   * Neither buffer may be touched until the request has completed.  Without
+   * MPI-3 nonblocking collectives this falls back to a blocking Allreduce and
+   * returns an already completed request.
+   */
+  template <typename T>
+  void Iallreduce(const T * sendbuf, T * recvbuf, int count, RawType_MPI_Op op,
+                  RawType_MPI_Request * request,
+                  const char* whereMsg, const char* whatMsg) const;
+
+  //! Nonblocking test for completion of \c request; returns true if it has completed.
+  bool               Test     (RawType_MPI_Request * request,
+                               const char* whereMsg, const char* whatMsg) const;
+
+  //! Blocks until \c request has completed.
+  void               Wait     (RawType_MPI_Request * request,
+                               const char* whereMsg, const char* whatMsg) const;
+
   //! Pause every process in *this communicator until all the processes reach this point.
   /*! Blocks the caller until all processes in the communicator have called it; that is,
    * the call returns at any process only after all members of the communicator have entered the call.*/
@@ -370,6 +399,15 @@ public:
    * \param tag message tag*/
   void               Send     (void *buf, int count, RawType_MPI_Datatype datatype, int dest, int tag,
                                const char* whereMsg, const char* whatMsg) const;
+
+  //! Nonblocking test for a pending message from another process.
+  /*!\param source rank of source (may be RawValue_MPI_ANY_SOURCE)
+   * \param tag message tag
+   *
+   * Returns true if a message matching \c source and \c tag can be received
+   * with Recv() without blocking.  Always false on a single process. */
+  bool               Iprobe   (int source, int tag,
+                               const char* whereMsg, const char* whatMsg) const;
  //@}
 
 //! @name Miscellaneous Methods
@@ -77,6 +77,18 @@ public:
   virtual double gammaSample   (double a, double b)        const = 0;
 
   //@}
+
+  //! @name State methods
+  //@{
+  //! Returns a new generator, of the same type and in the same state as this one.
+  /*! The two generators then produce the same samples independently of each
+   * other.  The caller owns the returned object. */
+  virtual RngBase* clone         ()                     const;
+
+  //! Puts this generator in the state of \c src, a generator of the same type.
+  /*! Like the sampling methods, it only moves the generator along its stream. */
+  virtual void     copyStateFrom (const RngBase & src)  const;
+  //@}
 protected:
   //! Seed.
           int m_seed;
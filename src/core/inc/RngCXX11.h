@@ -108,6 +108,16 @@ public:
    * Support (domain): [0, infinity).
    */
   double gammaSample(double a, double b) const;
+  //@}
+
+  //! @name State methods
+  //@{
+  //! Returns a new generator in the same state as this one.
+  RngBase* clone() const;
+
+  //! Puts this generator in the state of \c src, which must be a RngCXX11.
+  void copyStateFrom(const RngBase & src) const;
+  //@}
 
 private:
   //! Default Constructor: it should not be used.
@@ -101,6 +101,12 @@ public:
    * (domain): [0,infinity).*/
   double   gammaSample   (double a, double b)        const;
 
+  //! Returns a new generator in the same state as this one. Uses gsl_rng_memcpy().
+  RngBase* clone         ()                          const;
+
+  //! Puts this generator in the state of \c src, which must be a RngGsl.
+  void     copyStateFrom (const RngBase & src)       const;
+
   //! GSL random number generator.
   const gsl_rng* rng           () const;
 
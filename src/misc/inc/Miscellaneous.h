@@ -69,6 +69,11 @@ double       MiscDoubleDebugMessage         (double                    value,
 int          CheckFilePath                  (const char*               path);
 int          GRVY_CheckDir                  (const char*               dirname);
 
+//! Writes the matlab ending, if any, of a streamed sequence and closes its file.
+void         MiscCloseStreamedSequenceFile  (const BaseEnvironment&    env,
+                                               FilePtrSetStruct&         filePtrSet,
+                                               const std::string&        fileType);
+
 template <class T>
 bool MiscCheckForSameValueInAllNodes(T & inputValue, // Yes, 'not' const
     double acceptableTreshold, const MpiComm& comm, const char * whereString);
@@ -90,6 +90,12 @@ public:
   //! Sets a value to be used in the normalization style of the prior density PDF (ie, protected attribute m_priorDensity).
   void   setNormalizationStyle    (unsigned int value) const;
 
+  //! Sets the exponent applied to the likelihood function, e.g. an inverse temperature.
+  void   setLikelihoodExponent    (double value);
+
+  //! Returns the exponent applied to the likelihood function.
+  double likelihoodExponent       () const;
+
   //! Returns the logarithm of the last computed Prior value. Access to protected attribute m_lastComputedLogPrior.
   double lastComputedLogPrior     () const;
 
@@ -26,6 +26,7 @@
 #define UQ_BETA_JOINT_PROB_DENSITY_H
 
 #include <cmath>
+#include <vector>
 
 #include <queso/JointPdf.h>
 #include <queso/Environment.h>
@@ -66,10 +67,10 @@ public:
   double actualValue(const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Logarithm of the value of the Beta PDF.
-  /*! If the normalization style (m_normalizationStyle) is zero, then this routine calls a environment method
-   * which handles basic PDFs, e.g. basicPdfs()->betaPdfActualValue() and adds the log of the normalization
-   * factor (m_logOfNormalizationFactor) to it; otherwise the method uses the formula: \f$ lnValue =
-   * \sum[ (alpha_i-1)*log(domainVector_i) + (beta_i-1)*log(1-domainVector_i)] + m_logOfNormalizationFactor \f$. */
+  /*! The method uses the formula: \f$ lnValue =
+   * \sum[ (alpha_i-1)*log(domainVector_i) + (beta_i-1)*log(1-domainVector_i)] + m_logOfNormalizationFactor \f$,
+   * plus the log of the Beta function normalisers (precomputed at construction) if the normalization
+   * style (m_normalizationStyle) is zero. */
   double lnValue    (const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Mean value of the underlying random variable.
@@ -94,6 +95,11 @@ protected:
 
   V m_alpha;
   V m_beta;
+
+  //! Parameter-only terms of the log-density, computed once at construction
+  std::vector<double> m_alphaMinusOne;
+  std::vector<double> m_betaMinusOne;
+  double              m_sumLogNormalizers;
 };
 
 }  // End namespace QUESO
@@ -26,6 +26,7 @@
 #define UQ_CONCAT_JOINT_PROB_DENSITY_H
 
 #include <cmath>
+#include <vector>
 
 #include <queso/JointPdf.h>
 #include <queso/Environment.h>
@@ -76,11 +77,14 @@ public:
   //! @name Math methods
   //@{
   //! Calculates the actual values of each density.
-  /*! The final actual value is the multiplication of all values calculated.*/
+  /*! The final actual value is the multiplication of all values calculated.  If \c gradVector
+   * is given, each density's gradient is scaled by the values of the other densities and
+   * stored in the corresponding block of \c gradVector.*/
   double actualValue          (const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Calculates the logarithm of the values of each density.
-  /*! The final logarithm value is the addition of all values calculated.*/
+  /*! The final logarithm value is the addition of all values calculated.  If \c gradVector
+   * is given, it is the concatenation of the densities' log-gradients.*/
   double lnValue              (const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Mean value of the underlying random variable.
@@ -107,6 +111,14 @@ protected:
   using BaseJointPdf<V,M>::m_logOfNormalizationFactor;
 
   std::vector<const BaseJointPdf<V,M>* > m_densities;
+
+private:
+  //! Allocates the per-density work vectors once, so evaluations do not allocate.
+  void allocateWorkVectors();
+
+  mutable std::vector<V*>    m_subVectors;
+  mutable std::vector<V*>    m_subGradients;
+  mutable std::vector<double> m_subValues;
 };
 
 }  // End namespace QUESO
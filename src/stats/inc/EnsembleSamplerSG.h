@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_ENSEMBLE_SAMPLER_SG_H
+#define UQ_ENSEMBLE_SAMPLER_SG_H
+
+#include <queso/MetropolisHastingsSGOptions.h>
+#include <queso/BayesianJointPdf.h>
+#include <queso/VectorRV.h>
+#include <queso/VectorSequence.h>
+#include <queso/ScalarSequence.h>
+#include <queso/ScopedPtr.h>
+
+#include <vector>
+
+#define UQ_ENSEMBLE_SG_NUM_WALKERS_ODV        0
+#define UQ_ENSEMBLE_SG_STRETCH_SCALE_ODV      2.
+#define UQ_ENSEMBLE_SG_DE_PROBABILITY_ODV     0.
+
+//! Maximum number of draws when looking for an initial walker inside the domain.
+#define UQ_ENSEMBLE_SG_MAX_INITIAL_DRAWS      1000
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file EnsembleSamplerSG.h
+    \brief Affine-invariant ensemble sequence generator
+*/
+
+/*! \class EnsembleSamplerSG
+ *  \brief Affine-invariant ensemble sampler with parallel half-ensemble updates.
+ *
+ * An ensemble of walkers is split in two halves; each half is moved with
+ * the other one held fixed, so all the moves of a half are independent.
+ * Each walker takes either
+ *  - the stretch move of Goodman and Weare, Y = X_j + z (X_k - X_j) with X_j
+ *    drawn from the other half and z from g(z) ~ 1/sqrt(z) on [1/a, a], or,
+ *    with probability deProbability(),
+ *  - the differential evolution move of ter Braak,
+ *    Y = X_k + gamma (X_i - X_j) + e with X_i, X_j drawn from the other half
+ *    and gamma = 2.38 / sqrt(2 dim).
+ * Both moves are invariant under affine maps of the parameters, so poorly
+ * scaled or strongly correlated posteriors need no proposal covariance.
+ *
+ * The walkers of a half are dealt out round-robin over all the processes of
+ * fullComm(); each process evaluates the posterior of its walkers and one
+ * Allreduce per half step gives every process the whole ensemble.  The
+ * likelihood must therefore be evaluable independently by every process.
+ * All the processes draw the random numbers of every walker, in walker
+ * order, so with a nonnegative seed the chain does not depend on the
+ * number of processes.
+ *
+ * The raw chain stores the ensemble after each step, walker after walker,
+ * until MhOptionsValues::m_rawChainSize positions have been written, and is
+ * written to the usual raw chain output file.
+ */
+template <class P_V = GslVector, class P_M = GslMatrix>
+class EnsembleSamplerSG
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor.
+  /*! If \c alternativeOptionsValues is NULL the Metropolis-Hastings options
+   * are read from the input file with prefix \c prefix.  The walkers start as
+   * Gaussian draws with mean \c initialPosition and covariance
+   * \c initialCovMatrix or, if the latter is NULL, as draws from the prior. */
+  EnsembleSamplerSG(const char*                         prefix,
+                    const MhOptionsValues*              alternativeOptionsValues,
+                    const BaseVectorRV<P_V,P_M>&        priorRv,
+                    const BaseScalarFunction<P_V,P_M>&  likelihoodFunction,
+                    const P_V&                          initialPosition,
+                    const P_M*                          initialCovMatrix);
+
+  //! Destructor
+  ~EnsembleSamplerSG();
+  //@}
+
+  //! @name Set methods
+  //@{
+  //! Number of walkers; must be even and at least 4. 0 (the default) means 2 dim + 2.
+  void setNumWalkers(unsigned int numWalkers);
+
+  //! Scale a > 1 of the stretch move.
+  void setStretchScale(double stretchScale);
+
+  //! Probability of a differential evolution move instead of a stretch move.
+  void setDifferentialEvolutionProbability(double deProbability);
+  //@}
+
+  //! @name Statistical methods
+  //@{
+  //! Generates the chain; must be called on all processes of fullComm().
+  void generateSequence(BaseVectorSequence<P_V,P_M>& workingChain,
+                        ScalarSequence<double>*      workingLogLikelihoodValues,
+                        ScalarSequence<double>*      workingLogTargetValues);
+  //@}
+
+  //! @name Access methods
+  //@{
+  //! Number of walkers used by generateSequence().
+  unsigned int numWalkers() const;
+
+  //! Fraction of accepted moves over the whole ensemble.
+  double acceptanceRatio() const;
+  //@}
+
+private:
+  //! Draws the initial walkers, evaluated by the processes they are dealt out to.
+  void initializeEnsemble();
+
+  //! Moves the walkers of half \c half, the other half held fixed.
+  void updateHalf(unsigned int half);
+
+  //! Sums the walker slots filled by each process into m_walkers.
+  /*! The slots [first, first + count) are the ones that were updated. */
+  void gatherWalkers(unsigned int first, unsigned int count);
+
+  //! Stores a walker in slot \c w of m_buffer.
+  void storeWalker(unsigned int w, const P_V& position, double logTarget, double logLikelihood);
+
+  const BaseEnvironment&                   m_env;
+  const VectorSpace<P_V,P_M>&              m_vectorSpace;
+  const BaseVectorRV<P_V,P_M>&             m_priorRv;
+  const BaseScalarFunction<P_V,P_M>&       m_likelihoodFunction;
+
+  ScopedPtr<MhOptionsValues>::Type                      m_optionsObj;
+  typename ScopedPtr<VectorSet<P_V,P_M> >::Type         m_targetDomain;
+  typename ScopedPtr<BayesianJointPdf<P_V,P_M> >::Type  m_targetPdf;
+
+  P_V                 m_initialPosition;
+  bool                m_useInitialCovMatrix;
+  P_M                 m_initialCholFactor;
+
+  unsigned int        m_dim;
+  unsigned int        m_numWalkers;
+  double              m_stretchScale;
+  double              m_deProbability;
+
+  // Walker w occupies m_walkers[w*(dim+2) ...]: position, log-target,
+  // log-likelihood
+  std::vector<double> m_walkers;
+  std::vector<double> m_buffer;
+
+  double              m_numProposed;
+  double              m_numAccepted;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_ENSEMBLE_SAMPLER_SG_H
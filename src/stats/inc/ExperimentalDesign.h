@@ -0,0 +1,187 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+
+#ifndef UQ_EXPERIMENTAL_DESIGN_H
+#define UQ_EXPERIMENTAL_DESIGN_H
+
+#include <queso/Environment.h>
+#include <queso/VectorRV.h>
+#include <queso/VectorFunction.h>
+
+#ifdef QUESO_HAS_ANN
+#include <queso/InfoTheory.h>
+#endif
+
+#include <string>
+#include <vector>
+
+#define UQ_EXP_DESIGN_NUM_OUTER_SAMPLES_ODV 1000
+#define UQ_EXP_DESIGN_NUM_INNER_SAMPLES_ODV 1000
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file ExperimentalDesign.h
+    \brief Expected information gain of candidate experimental designs
+*/
+
+/*! \class ExperimentalDesign
+ *  \brief Ranks candidate experimental designs by their expected information gain.
+ *
+ * The QoI function maps a parameter vector to every quantity that could be
+ * measured (e.g. the model output at all candidate sensor locations).  A
+ * design is the subset of those QoIs that is actually observed; each observed
+ * QoI is corrupted by independent Gaussian noise of the given standard
+ * deviation.  The expected information gain (EIG) of a design d is the mutual
+ * information between the parameters and the observations y_d,
+ * \f[ EIG(d) = E_{\theta,y}\left[ \log p(y_d|\theta) - \log p(y_d) \right]. \f]
+ *
+ * Prior samples, QoI values and noise draws are computed once and shared by
+ * all the designs, so designs are compared with common random numbers and the
+ * model is never evaluated more than \c numOuterSamples times.  The sample
+ * computation is split across the subenvironments and the candidates are then
+ * evaluated in parallel, candidate \c c on subenvironment
+ * <tt>c % numSubEnvironments()</tt>.
+ *
+ * The default estimator is nested Monte Carlo.  The inner loop estimating the
+ * evidence p(y_d) reuses the first \c numInnerSamples outer samples (and their
+ * QoI values) instead of drawing new ones, which costs no extra model
+ * evaluations.  When QUESO is built with ANN, the EIG can instead be estimated
+ * with the k-nearest-neighbour mutual information estimator of InfoTheory.h.
+ */
+template <class P_V = GslVector, class P_M = GslMatrix, class Q_V = GslVector, class Q_M = GslMatrix>
+class ExperimentalDesign
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor.
+  /*! \c noiseStdDevs holds the observation noise standard deviation of each
+   * QoI and must live in the image space of \c qoiFunction. */
+  ExperimentalDesign(const char*                                prefix,
+                     const BaseVectorRV<P_V,P_M>&               priorRv,
+                     const BaseVectorFunction<P_V,P_M,Q_V,Q_M>& qoiFunction,
+                     const Q_V&                                 noiseStdDevs);
+
+  //! Destructor
+  ~ExperimentalDesign();
+  //@}
+
+  //! @name Set methods
+  //@{
+  //! Number of outer (prior) samples and of inner samples used for the evidence.
+  /*! \c numInnerSamples must not exceed \c numOuterSamples. Discards any
+   * samples computed with the previous sizes. */
+  void setNumSamples(unsigned int numOuterSamples, unsigned int numInnerSamples);
+
+  //! Adds a candidate design observing the QoIs \c observedQois; returns its id.
+  unsigned int addDesign(const std::vector<unsigned int>& observedQois);
+
+#ifdef QUESO_HAS_ANN
+  //! Use the k-NN mutual information estimator with \c k neighbours.
+  /*! \c k == 0 restores the nested Monte Carlo estimator. */
+  void setKnnEstimator(unsigned int k);
+#endif
+  //@}
+
+  //! @name Computation methods
+  //@{
+  //! Draws the prior samples, evaluates the QoI function and draws the noise.
+  /*! Called by computeExpectedInformationGains() if needed; must be called on
+   * all processes. */
+  void computeSamples();
+
+  //! Estimates the EIG of every design not yet evaluated.
+  /*! Must be called on all processes; on return every process holds all the
+   * estimates. Designs added later are evaluated by the next call, reusing
+   * the same samples. */
+  void computeExpectedInformationGains();
+  //@}
+
+  //! @name Access methods
+  //@{
+  //! Number of candidate designs
+  unsigned int numDesigns() const;
+
+  //! Estimated EIG of design \c designId
+  double expectedInformationGain(unsigned int designId) const;
+
+  //! Id of the design with the largest estimated EIG
+  unsigned int bestDesign() const;
+
+  //! Prints the EIG of each design
+  void print(std::ostream& os) const;
+  //@}
+
+private:
+  //! Nested Monte Carlo estimate of the EIG of design \c designId
+  double nestedMonteCarloEig(unsigned int designId) const;
+
+#ifdef QUESO_HAS_ANN
+  //! k-NN mutual information estimate of the EIG of design \c designId
+  double knnEig(unsigned int designId) const;
+#endif
+
+  const BaseEnvironment&                     m_env;
+  std::string                                m_prefix;
+  const BaseVectorRV<P_V,P_M>&               m_priorRv;
+  const BaseVectorFunction<P_V,P_M,Q_V,Q_M>& m_qoiFunction;
+
+  unsigned int m_paramDim;
+  unsigned int m_qoiDim;
+
+  //! Observation noise standard deviation of each QoI
+  std::vector<double> m_noiseStdDevs;
+
+  unsigned int m_numOuterSamples;
+  unsigned int m_numInnerSamples;
+  unsigned int m_knn;
+
+  //! Row-major numOuterSamples x paramDim prior samples
+  std::vector<double> m_paramSamples;
+
+  //! Row-major numOuterSamples x qoiDim QoI values
+  std::vector<double> m_qoiSamples;
+
+  //! Row-major numOuterSamples x qoiDim standard normal noise draws
+  std::vector<double> m_noiseSamples;
+
+  bool m_samplesComputed;
+
+  std::vector<std::vector<unsigned int> > m_designs;
+  std::vector<double> m_eigs;
+  std::vector<bool> m_evaluated;
+
+#ifdef QUESO_HAS_ANN
+  //! Trees and buffers shared by the knnEig() calls of all the designs
+  mutable MutualInfoWorkspaceANN m_miWorkspace;
+#endif
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_EXPERIMENTAL_DESIGN_H
@@ -26,6 +26,7 @@
 #define UQ_GAMMA_JOINT_PROB_DENSITY_H
 
 #include <cmath>
+#include <vector>
 
 #include <queso/JointPdf.h>
 #include <queso/Environment.h>
@@ -86,11 +87,10 @@ public:
   double actualValue(const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Logarithm of the value of the Gamma PDF.
-  /*! If the normalization style (m_normalizationStyle) is zero, then this routine calls a environment method
-   * which handles basic PDFs, e.g. basicPdfs()->gammaPdfActualValue() and adds the log of the normalization
-   * factor (m_logOfNormalizationFactor) to it; otherwise the method uses the formula: \f$ lnValue =
+  /*! The method uses the formula: \f$ lnValue =
    * \sum[ (a_i-1)*log(domainVector_i) -domainVector_i/b_i + m_logOfNormalizationFactor \f$, where a and b
-   * are the parameters of the Gamma PDF. */
+   * are the parameters of the Gamma PDF, plus \f$ -\sum[ \log \Gamma(a_i) + a_i \log b_i ] \f$
+   * (precomputed at construction) if the normalization style (m_normalizationStyle) is zero. */
   double lnValue    (const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Mean value of the underlying random variable.
@@ -115,6 +115,11 @@ protected:
 
   V m_a;
   V m_b;
+
+  //! Parameter-only terms of the log-density, computed once at construction
+  std::vector<double> m_aMinusOne;
+  std::vector<double> m_invB;
+  double              m_sumLogNormalizers;
 };
 
 }  // End namespace QUESO
@@ -127,6 +127,10 @@ protected:
   V*       m_lawVarVector;
   bool     m_diagonalCovMatrix;
   const M* m_lawCovMatrix;
+
+  //! Work vectors reused by every lnValue() call
+  mutable V m_diffVec;
+  mutable V m_solveVec;
 };
 
 }  // End namespace QUESO
@@ -113,6 +113,10 @@ private:
   V* m_vecSsqrt;
   M* m_matVt;
 
+  //! Work vectors reused by every realization() call
+  mutable V m_iidGaussianVector;
+  mutable V m_svdWorkVector;
+
   using BaseVectorRealizer<V,M>::m_env;
   using BaseVectorRealizer<V,M>::m_prefix;
   using BaseVectorRealizer<V,M>::m_unifiedImageSet;
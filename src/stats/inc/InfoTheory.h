@@ -28,6 +28,8 @@
 #include <queso/Defines.h>
 #ifdef QUESO_HAS_ANN
 
+#include <vector>
+
 #include <ANN/ANN.h>
 #include <ANN/ANNx.h>
 
@@ -36,8 +38,120 @@
 #define UQ_INFTH_ANN_EPS           0.0
 #define UQ_INFTH_ANN_KNN           6
 
+// Number of consecutive queries handed to a thread at a time
+#define UQ_INFTH_ANN_BATCH         64
+
 namespace QUESO {
 
+/*!
+ * \class KnnSearchANN
+ * \brief Reusable, thread-parallel k-nearest-neighbour queries on an ANN kd-tree.
+ *
+ * The tree and the per-thread scratch buffers are owned by the object, so a
+ * caller that evaluates the estimators repeatedly (e.g. inside an
+ * experimental design loop) only pays for a tree rebuild per data set, not
+ * for reallocating the query buffers.  When QUESO is built with OpenMP the
+ * queries are split over threads in batches of UQ_INFTH_ANN_BATCH; the
+ * results do not depend on the number of threads.
+ */
+class KnnSearchANN
+{
+public:
+  //! Empty searcher; call build() before querying.
+  KnnSearchANN();
+
+  ~KnnSearchANN();
+
+  //! (Re)builds the kd-tree on the \c n points of \c data, of dimension \c dim.
+  /*! The points are not copied and must outlive the queries. */
+  void build(ANNpointArray data, unsigned int n, unsigned int dim);
+
+  //! Number of points in the tree
+  unsigned int size() const { return m_n; }
+
+  //! For each query point, the distance to its (k+1)-th nearest neighbour.
+  /*!
+   * This is the entry nnDist[k] of a (k+1)-neighbour search.  If that
+   * distance is zero (the query coincides with more than k points) the
+   * distance to the nearest point at positive distance is returned instead;
+   * the coincident points are counted with a zero-radius search, so no
+   * search over all the points is ever needed.
+   */
+  void kthDistances(const ANNpointArray queries, unsigned int nq,
+                    unsigned int k, double eps, double* dists);
+
+  //! As kthDistances(), with the tree's own points as the queries.
+  /*!
+   * The queries are issued in the tree's leaf order, so that consecutive
+   * queries walk the same part of the tree.  dists is indexed as the
+   * original data.
+   */
+  void kthDistancesSelf(unsigned int k, double eps, double* dists);
+
+  //! For each query point i, the number of points within distance radii[i].
+  void countInRadius(const ANNpointArray queries, unsigned int nq,
+                     const double* radii, double eps, int* counts);
+
+private:
+  KnnSearchANN(const KnnSearchANN&);
+  KnnSearchANN& operator=(const KnnSearchANN&);
+
+  //! Distance to the (k+1)-th neighbour of q, skipping zero-distance ties.
+  double kthDistance(ANNpoint q, unsigned int k, double eps,
+                     std::vector<ANNidx>& idx, std::vector<ANNdist>& dist);
+
+  //! Makes sure each thread has scratch buffers for at least \c k neighbours.
+  void reserveScratch(unsigned int k);
+
+  ANNkd_tree* m_tree;
+  ANNpointArray m_data;
+  unsigned int m_n;
+  unsigned int m_dim;
+
+  //! Tree leaf order of the points (used for self queries)
+  std::vector<ANNidx> m_order;
+
+  //! Per-thread neighbour index and distance buffers
+  std::vector<std::vector<ANNidx> > m_idx;
+  std::vector<std::vector<ANNdist> > m_dist;
+};
+
+/*!
+ * \class MutualInfoWorkspaceANN
+ * \brief Trees and buffers reused across calls to computeMI_ANN().
+ */
+class MutualInfoWorkspaceANN
+{
+public:
+  MutualInfoWorkspaceANN();
+
+  ~MutualInfoWorkspaceANN();
+
+  //! Sizes the point arrays and buffers for \c N points; no-op if unchanged.
+  void resize(unsigned int N, unsigned int dimX, unsigned int dimY);
+
+  KnnSearchANN jointSearch;
+  KnnSearchANN xSearch;
+  KnnSearchANN ySearch;
+
+  //! Joint samples and their marginals, N points each
+  ANNpointArray dataXY;
+  ANNpointArray dataX;
+  ANNpointArray dataY;
+
+  std::vector<double> distsXY;
+  std::vector<int> countsX;
+  std::vector<int> countsY;
+
+private:
+  MutualInfoWorkspaceANN(const MutualInfoWorkspaceANN&);
+  MutualInfoWorkspaceANN& operator=(const MutualInfoWorkspaceANN&);
+
+  unsigned int m_N;
+  unsigned int m_dimX;
+  unsigned int m_dimY;
+};
+
 /*!
  * For each point q in dataX, this performs a k-Nearest Neighbours search
  * of the points in dataY closest to q.  The array distsXY is filled with the
@@ -71,6 +185,15 @@ double computeMI_ANN( ANNpointArray dataXY,
                       unsigned int dimX, unsigned int dimY,
                       unsigned int k, unsigned int N, double eps );
 
+/*!
+ * Computes the mutual information, reusing the trees and buffers held in
+ * \c workspace from previous calls
+ */
+double computeMI_ANN( ANNpointArray dataXY,
+                      unsigned int dimX, unsigned int dimY,
+                      unsigned int k, unsigned int N, double eps,
+                      MutualInfoWorkspaceANN& workspace );
+
 /*!
  * Function: estimateMI_ANN (using a joint)
  * (Mutual Information)
@@ -83,13 +206,25 @@ double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
                        const unsigned int yDimSel[], unsigned int dimY,
                        unsigned int k, unsigned int N, double eps );
 
+/*!
+ * As above, drawing the samples into \c workspace and reusing its trees and
+ * buffers; intended for callers that estimate the mutual information many
+ * times with the same sizes.
+ */
+template <template <class P_V, class P_M> class RV, class P_V, class P_M>
+double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
+                       const unsigned int xDimSel[], unsigned int dimX,
+                       const unsigned int yDimSel[], unsigned int dimY,
+                       unsigned int k, unsigned int N, double eps,
+                       MutualInfoWorkspaceANN& workspace );
+
 /*!
  * Function: estimateMI_ANN (using two seperate RVs)
  * (Mutual Information)
  */
 template <class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateMI_ANN( const RV_1<P_V,P_M>& xRV,
                        const RV_2<P_V,P_M>& yRV,
                        const unsigned int xDimSel[], unsigned int dimX,
@@ -104,8 +239,8 @@ double estimateMI_ANN( const RV_1<P_V,P_M>& xRV,
  * xRV and yRV.
  */
 template <class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateKL_ANN( RV_1<P_V,P_M>& xRV,
                        RV_2<P_V,P_M>& yRV,
                        unsigned int xDimSel[], unsigned int dimX,
@@ -120,8 +255,8 @@ double estimateKL_ANN( RV_1<P_V,P_M>& xRV,
  * Estimates the cross-entropy of two queso random variables xRV and yRV
  */
 template <class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateCE_ANN( RV_1<P_V,P_M>& xRV,
                        RV_2<P_V,P_M>& yRV,
                        unsigned int xDimSel[], unsigned int dimX,
@@ -32,60 +32,249 @@
 
 #include <gsl/gsl_sf_psi.h> // todo: take specificity of gsl_, i.e., make it general (gsl or boost or etc)
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace QUESO {
 
+//*****************************************************
+// Helpers for the threaded k-NN queries
+//*****************************************************
+inline unsigned int infoTheoryMaxThreads()
+{
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+inline unsigned int infoTheoryThreadId()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// ANN keeps the leaf order of the points in a protected member; expose it
+// so that self queries can be issued in that order.
+class LeafOrderedKdTreeANN : public ANNkd_tree
+{
+public:
+  LeafOrderedKdTreeANN( ANNpointArray pa, int n, int dd )
+    : ANNkd_tree( pa, n, dd )
+  {}
+
+  const ANNidx* leafOrder() const { return pidx; }
+};
+
+//*****************************************************
+// Class: KnnSearchANN
+//*****************************************************
+KnnSearchANN::KnnSearchANN()
+  : m_tree(NULL),
+    m_data(NULL),
+    m_n(0),
+    m_dim(0)
+{
+}
+
+KnnSearchANN::~KnnSearchANN()
+{
+  delete m_tree;
+}
+
+void KnnSearchANN::build( ANNpointArray data, unsigned int n, unsigned int dim )
+{
+  queso_require_greater_msg(n, 0, "cannot build a kd-tree on zero points");
+
+  delete m_tree;
+  m_tree = NULL;
+
+  LeafOrderedKdTreeANN* tree = new LeafOrderedKdTreeANN( data, n, dim );
+  m_order.assign( tree->leafOrder(), tree->leafOrder() + n );
+
+  m_tree = tree;
+  m_data = data;
+  m_n = n;
+  m_dim = dim;
+}
+
+void KnnSearchANN::reserveScratch( unsigned int k )
+{
+  unsigned int n_threads = infoTheoryMaxThreads();
+  if( m_idx.size() < n_threads ) {
+    m_idx.resize( n_threads );
+    m_dist.resize( n_threads );
+  }
+
+  for( unsigned int t = 0; t < m_idx.size(); t++ ) {
+    if( m_idx[t].size() < k ) {
+      m_idx[t].resize( k );
+      m_dist[t].resize( k );
+    }
+  }
+}
+
+double KnnSearchANN::kthDistance( ANNpoint q, unsigned int k, double eps,
+                                  std::vector<ANNidx>& idx,
+                                  std::vector<ANNdist>& dist )
+{
+  m_tree->annkSearch( q, k+1, &idx[0], &dist[0], eps );
+
+  double my_dist = dist[ k ];
+
+  // check to see if the dist is zero (query point same as the kNN)
+  // if so find the next k that gives the next positive distance.  The
+  // coincident points are counted first, so the second search only needs
+  // one neighbour more than there are ties.
+  if( my_dist == 0.0 ) {
+    unsigned int n_tied = m_tree->annkFRSearch( q, 0.0, 0, NULL, NULL, 0.0 );
+
+    if( n_tied < m_n ) {
+      if( idx.size() < n_tied + 1 ) {
+        idx.resize( n_tied + 1 );
+        dist.resize( n_tied + 1 );
+      }
+      m_tree->annkSearch( q, n_tied+1, &idx[0], &dist[0], eps );
+
+      for( unsigned int my_k = k + 1; my_k <= n_tied; ++my_k ) {
+        if( dist[ my_k ] > 0.0 ) {
+          my_dist = dist[ my_k ];
+          break;
+        }
+      }
+    }
+  }
+
+  return my_dist;
+}
+
+void KnnSearchANN::kthDistances( const ANNpointArray queries, unsigned int nq,
+                                 unsigned int k, double eps, double* dists )
+{
+  queso_require_msg(m_tree, "kd-tree has not been built");
+  queso_require_less_msg(k, m_n, "not enough points for the requested neighbour");
+
+  this->reserveScratch( k+1 );
+
+  int n_queries = nq;
+
+#ifdef _OPENMP
+#pragma omp parallel if(n_queries > UQ_INFTH_ANN_BATCH)
+#endif
+  {
+    std::vector<ANNidx>& idx = m_idx[ infoTheoryThreadId() ];
+    std::vector<ANNdist>& dist = m_dist[ infoTheoryThreadId() ];
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, UQ_INFTH_ANN_BATCH)
+#endif
+    for( int i = 0; i < n_queries; i++ ) {
+      dists[ i ] = this->kthDistance( queries[ i ], k, eps, idx, dist );
+    }
+  }
+}
+
+void KnnSearchANN::kthDistancesSelf( unsigned int k, double eps, double* dists )
+{
+  queso_require_msg(m_tree, "kd-tree has not been built");
+  queso_require_less_msg(k, m_n, "not enough points for the requested neighbour");
+
+  this->reserveScratch( k+1 );
+
+  int n_queries = m_n;
+
+#ifdef _OPENMP
+#pragma omp parallel if(n_queries > UQ_INFTH_ANN_BATCH)
+#endif
+  {
+    std::vector<ANNidx>& idx = m_idx[ infoTheoryThreadId() ];
+    std::vector<ANNdist>& dist = m_dist[ infoTheoryThreadId() ];
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, UQ_INFTH_ANN_BATCH)
+#endif
+    for( int i = 0; i < n_queries; i++ ) {
+      ANNidx p = m_order[ i ];
+      dists[ p ] = this->kthDistance( m_data[ p ], k, eps, idx, dist );
+    }
+  }
+}
+
+void KnnSearchANN::countInRadius( const ANNpointArray queries, unsigned int nq,
+                                  const double* radii, double eps, int* counts )
+{
+  queso_require_msg(m_tree, "kd-tree has not been built");
+
+  int n_queries = nq;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, UQ_INFTH_ANN_BATCH) if(n_queries > UQ_INFTH_ANN_BATCH)
+#endif
+  for( int i = 0; i < n_queries; i++ ) {
+    counts[ i ] = m_tree->annkFRSearch( queries[ i ], radii[ i ], 0, NULL, NULL, eps );
+  }
+}
+
+//*****************************************************
+// Class: MutualInfoWorkspaceANN
+//*****************************************************
+MutualInfoWorkspaceANN::MutualInfoWorkspaceANN()
+  : dataXY(NULL),
+    dataX(NULL),
+    dataY(NULL),
+    m_N(0),
+    m_dimX(0),
+    m_dimY(0)
+{
+}
+
+MutualInfoWorkspaceANN::~MutualInfoWorkspaceANN()
+{
+  if( dataXY ) annDeallocPts( dataXY );
+  if( dataX ) annDeallocPts( dataX );
+  if( dataY ) annDeallocPts( dataY );
+}
+
+void MutualInfoWorkspaceANN::resize( unsigned int N, unsigned int dimX, unsigned int dimY )
+{
+  if( N == m_N && dimX == m_dimX && dimY == m_dimY ) {
+    return;
+  }
+
+  if( dataXY ) annDeallocPts( dataXY );
+  if( dataX ) annDeallocPts( dataX );
+  if( dataY ) annDeallocPts( dataY );
+
+  dataXY = annAllocPts( N, dimX + dimY );
+  dataX = annAllocPts( N, dimX );
+  dataY = annAllocPts( N, dimY );
+  distsXY.resize( N );
+  countsX.resize( N );
+  countsY.resize( N );
+
+  m_N = N;
+  m_dimX = dimX;
+  m_dimY = dimY;
+}
+
 //*****************************************************
 // Function: distANN_XY
 //*****************************************************
 void distANN_XY( const ANNpointArray dataX, const ANNpointArray dataY,
 		 double* distsXY,
-		 unsigned int dimX, unsigned int dimY,
+		 unsigned int /* dimX */, unsigned int dimY,
 		 unsigned int xN, unsigned int yN,
 		 unsigned int k, double eps )
 {
+  KnnSearchANN search;
 
-  ANNkd_tree* kdTree;
-  ANNdistArray nnDist;
-  ANNidxArray nnIdx;
-
-  // Allocate memory
-  nnIdx = new ANNidx[ k+1 ];
-  nnDist = new ANNdist[ k+1 ];
-  kdTree = new ANNkd_tree( dataY, yN, dimY );
-
-  // Get the distances to all the points
-  for( unsigned int i = 0; i < xN ; i++ )
-    {
-      kdTree->annkSearch( dataX[ i ], k+1, nnIdx, nnDist, eps );
-
-      double my_dist = nnDist[ k ];
-
-      // check to see if the dist is zero (query point same as the kNN)
-      // if so find the next k that gives the next positive distance
-      if( my_dist == 0.0 )
-	{
-	  ANNdistArray nnDist_tmp = new ANNdist[ yN ];
-	  ANNidxArray nnIdx_tmp = new ANNidx[ yN ];
-	  kdTree->annkSearch( dataX[ i ], yN, nnIdx_tmp, nnDist_tmp, eps );
-
-	  for( unsigned int my_k = k + 1; my_k < yN; ++my_k )
-	    if( nnDist_tmp[ my_k ] > 0.0 )
-	      {
-		my_dist = nnDist_tmp[ my_k ];
-		break;
-	      }
-	  delete [] nnIdx_tmp;
-	  delete [] nnDist_tmp;
-	}
-
-      distsXY[ i ] = my_dist;
-    }
-
-  // Deallocate memory
-  delete [] nnIdx;
-  delete [] nnDist;
-  delete kdTree;
-  annClose();
+  search.build( dataY, yN, dimY );
+  search.kthDistances( dataX, xN, k, eps, distsXY );
 
   return;
 }
@@ -162,46 +351,46 @@ double computeMI_ANN( ANNpointArray dataXY,
 		      unsigned int dimX, unsigned int dimY,
 		      unsigned int k, unsigned int N, double eps )
 {
+  MutualInfoWorkspaceANN workspace;
 
-  ANNpointArray dataX, dataY;
-  double* distsXY;
+  return computeMI_ANN( dataXY, dimX, dimY, k, N, eps, workspace );
+}
+
+double computeMI_ANN( ANNpointArray dataXY,
+		      unsigned int dimX, unsigned int dimY,
+		      unsigned int k, unsigned int N, double eps,
+		      MutualInfoWorkspaceANN& workspace )
+{
   double MI_est;
-  ANNkd_tree* kdTreeX;
-  ANNkd_tree* kdTreeY;
 
   unsigned int dimXY = dimX + dimY;
 
-  // Allocate memory
-  dataX = annAllocPts(N,dimX);
-  dataY = annAllocPts(N,dimY);
-  distsXY = new double[N];
+  // Allocate memory (only if the sizes changed since the last call)
+  workspace.resize( N, dimX, dimY );
 
   // Normalize data and populate the marginals dataX, dataY
-  normalizeANN_XY( dataXY, dimXY, dataX, dimX, dataY, dimY, N);
+  normalizeANN_XY( dataXY, dimXY, workspace.dataX, dimX, workspace.dataY, dimY, N);
 
   // Get distance to knn for each point
-  kdTreeX = new ANNkd_tree( dataX, N, dimX );
-  kdTreeY = new ANNkd_tree( dataY, N, dimY );
-  distANN_XY( dataXY, dataXY, distsXY, dimXY, dimXY, N, N, k, eps );
-
-  // Compute mutual information
+  workspace.jointSearch.build( dataXY, N, dimXY );
+  workspace.jointSearch.kthDistancesSelf( k, eps, &workspace.distsXY[0] );
+
+  // get the number of points within the knn radius in each marginal
+  workspace.xSearch.build( workspace.dataX, N, dimX );
+  workspace.ySearch.build( workspace.dataY, N, dimY );
+  workspace.xSearch.countInRadius( workspace.dataX, N, &workspace.distsXY[0], eps,
+                                   &workspace.countsX[0] );
+  workspace.ySearch.countInRadius( workspace.dataY, N, &workspace.distsXY[0], eps,
+                                   &workspace.countsY[0] );
+
+  // Compute mutual information (digamma evaluations)
   double marginal_contrib = 0.0;
   for( unsigned int i = 0; i < N; i++ ) {
-    // get the number of points within a specified radius
-    int no_pts_X = kdTreeX->annkFRSearch( dataX[ i ], distsXY[ i ], 0, NULL, NULL, eps);
-    int no_pts_Y = kdTreeY->annkFRSearch( dataY[ i ], distsXY[ i ], 0, NULL, NULL, eps);
-    // digamma evaluations
-    marginal_contrib += gsl_sf_psi_int( no_pts_X+1 ) + gsl_sf_psi_int( no_pts_Y+1 );
+    marginal_contrib += gsl_sf_psi_int( workspace.countsX[ i ]+1 ) +
+                        gsl_sf_psi_int( workspace.countsY[ i ]+1 );
   }
   MI_est = gsl_sf_psi_int( k ) + gsl_sf_psi_int( N ) - marginal_contrib / (double)N;
 
-  // Deallocate memory
-  delete kdTreeX;
-  delete kdTreeY;
-  delete [] distsXY;
-  annDeallocPts( dataX );
-  annDeallocPts( dataY );
-
   return MI_est;
 
 }
@@ -216,13 +405,22 @@ double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
            const unsigned int yDimSel[], unsigned int dimY,
            unsigned int k, unsigned int N, double eps )
 {
-  ANNpointArray dataXY;
-  double MI_est;
+  MutualInfoWorkspaceANN workspace;
 
-  unsigned int dimXY = dimX + dimY;
+  return estimateMI_ANN( jointRV, xDimSel, dimX, yDimSel, dimY, k, N, eps,
+                         workspace );
+}
 
-  // Allocate memory
-  dataXY = annAllocPts(N,dimXY);
+template<template <class P_V, class P_M> class RV, class P_V, class P_M>
+double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
+           const unsigned int xDimSel[], unsigned int dimX,
+           const unsigned int yDimSel[], unsigned int dimY,
+           unsigned int k, unsigned int N, double eps,
+           MutualInfoWorkspaceANN& workspace )
+{
+  // Allocate memory (only if the sizes changed since the last call)
+  workspace.resize( N, dimX, dimY );
+  ANNpointArray dataXY = workspace.dataXY;
 
   // Copy samples in ANN data structure
   P_V smpRV( jointRV.imageSet().vectorSpace().zeroVector() );
@@ -237,17 +435,11 @@ double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
     for( unsigned int j = 0; j < dimY; j++ ) {
       dataXY[ i ][ dimX + j ] = smpRV[ yDimSel[j] ];
     }
-    // annPrintPt( dataXY[i], dimXY, std::cout ); std::cout << std::endl;
   }
 
-  MI_est = computeMI_ANN( dataXY,
+  return computeMI_ANN( dataXY,
         dimX, dimY,
-        k, N, eps );
-
-  // Deallocate memory
-  annDeallocPts( dataXY );
-
-  return MI_est;
+        k, N, eps, workspace );
 }
 
 //*****************************************************
@@ -255,8 +447,8 @@ double estimateMI_ANN( const RV<P_V,P_M>& jointRV,
 // (Mutual Information)
 //*****************************************************
 template<class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateMI_ANN( const RV_1<P_V,P_M>& xRV,
            const RV_2<P_V,P_M>& yRV,
            const unsigned int xDimSel[], unsigned int dimX,
@@ -305,8 +497,8 @@ double estimateMI_ANN( const RV_1<P_V,P_M>& xRV,
 // (Kullback-Leibler divergence)
 //*****************************************************
 template <class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateKL_ANN( RV_1<P_V,P_M>& xRV,
            RV_2<P_V,P_M>& yRV,
            unsigned int xDimSel[], unsigned int dimX,
@@ -353,9 +545,13 @@ double estimateKL_ANN( RV_1<P_V,P_M>& xRV,
     }
   }
 
-  // Get distance to knn for each point
-  distANN_XY( dataX, dataX, distsX, dimX, dimX, xN, xN, k+1, eps ); // k+1 because the 1st nn is itself
-  distANN_XY( dataX, dataY, distsXY, dimX, dimY, xN, yN, k, eps );
+  // Get distance to knn for each point (the scratch buffers of the
+  // searcher are reused for the second tree)
+  KnnSearchANN search;
+  search.build( dataX, xN, dimX );
+  search.kthDistancesSelf( k+1, eps, distsX ); // k+1 because the 1st nn is itself
+  search.build( dataY, yN, dimY );
+  search.kthDistances( dataX, xN, k, eps, distsXY );
 
   // Compute KL-divergence estimate
   double sum_log_ratio = 0.0;
@@ -380,8 +576,8 @@ double estimateKL_ANN( RV_1<P_V,P_M>& xRV,
 // (Cross Entropy)
 //*****************************************************
 template <class P_V, class P_M,
-  template <class P_V, class P_M> class RV_1,
-  template <class P_V, class P_M> class RV_2>
+  template <class, class> class RV_1,
+  template <class, class> class RV_2>
 double estimateCE_ANN( RV_1<P_V,P_M>& xRV,
            RV_2<P_V,P_M>& yRV,
            unsigned int xDimSel[], unsigned int dimX,
@@ -26,6 +26,7 @@
 #define UQ_INVGAMMA_JOINT_PROB_DENSITY_H
 
 #include <cmath>
+#include <vector>
 
 #include <queso/JointPdf.h>
 #include <queso/Environment.h>
@@ -68,8 +69,11 @@ public:
   /*! This routine calls method lnValue() and returns the exponent of the returning value of such method.*/
   double actualValue(const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
-  //! TODO: Logarithm of the value of the Gamma PDF.
-  /*! \todo: implement me!*/
+  //! Logarithm of the value of the Inverse Gamma PDF.
+  /*! The method uses the formula: \f$ lnValue =
+   * \sum[ -(alpha_i+1)*log(domainVector_i) - beta_i/domainVector_i ] + m_logOfNormalizationFactor \f$,
+   * plus \f$ \sum[ alpha_i \log beta_i - \log \Gamma(alpha_i) ] \f$ (precomputed at construction)
+   * if the normalization style (m_normalizationStyle) is zero. */
   double lnValue    (const V& domainVector, const V* domainDirection, V* gradVector, M* hessianMatrix, V* hessianEffect) const;
 
   //! Mean value of the underlying random variable.
@@ -94,6 +98,11 @@ protected:
 
   V m_alpha;
   V m_beta;
+
+  //! Parameter-only terms of the log-density, computed once at construction
+  std::vector<double> m_alphaPlusOne;
+  std::vector<double> m_betaValues;
+  double              m_sumLogNormalizers;
 };
 
 }  // End namespace QUESO
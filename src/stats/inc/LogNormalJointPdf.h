@@ -26,6 +26,7 @@
 #define UQ_LOGNORM_JOINT_PROB_DENSITY_H
 
 #include <cmath>
+#include <vector>
 
 #include <queso/JointPdf.h>
 #include <queso/Environment.h>
@@ -104,6 +105,11 @@ protected:
   V*   m_lawExpVector;
   V*   m_lawVarVector;
   bool m_diagonalCovMatrix;
+
+  //! Parameter-only terms of the log-density, computed once at construction
+  std::vector<double> m_mu;
+  std::vector<double> m_invVar;
+  double              m_sumLogNormalizers;
 };
 
 }  // End namespace QUESO
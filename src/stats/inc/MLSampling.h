@@ -41,9 +41,20 @@
 #endif
 #include <sys/time.h>
 #include <fstream>
+#ifdef QUESO_HAVE_CXX11
+#include <thread>
+#endif
 
 #define ML_CHECKPOINT_FIXED_AMOUNT_OF_DATA 6
 
+//! Restart file type of the binary checkpoint, written as one file per subenvironment.
+#define UQ_ML_SAMPLING_RESTART_BINARY_FILE_TYPE "bin"
+#define ML_CHECKPOINT_BINARY_MAGIC              "QUESOMLC"
+#define ML_CHECKPOINT_BINARY_VERSION            1
+
+//! Above this number of linked chains, load balancing algorithm 1 (BIP) falls back to algorithm 3 (LPT).
+#define ML_LOAD_BALANCE_MAX_NUM_CHAINS_FOR_BIP 1000
+
 //---------------------------------------------------------
 
 namespace QUESO {
@@ -68,8 +79,15 @@ struct ExchangeInfoStruct
   unsigned int originalIndexOfInitialPosition;
   int          finalNodeOfInitialPosition;
   unsigned int numberOfPositions;
+  double       estimatedCost; // numberOfPositions times the measured cost per position, if known
 };
 
+//! Assigns each chain to one of \c numNodes nodes with the longest processing time first (LPT) heuristic.
+/*! Chains are taken by decreasing \c estimatedCost (ties by chain id), each to the node with the least
+ *  total cost so far (then the fewest positions, then the lowest id); sets \c finalNodeOfInitialPosition.
+ *  The makespan is within 4/3 - 1/(3 numNodes) of the optimal one. */
+void lptAssignChains(unsigned int numNodes, std::vector<ExchangeInfoStruct>& exchangeStdVec);
+
 //---------------------------------------------------------
 
 template <class P_V = GslVector>
@@ -210,13 +228,38 @@ public:
 
 private:
  //! Writes checkpoint data for the ML method.
- /*!*/
- /*!@param[in]  currExponent, currEta, currChain, currLogLikelihoodValues, currLogTargetValues.*/
+ /*! With the binary file type and \c deferBinaryData set (another level follows), nothing is written
+  * yet: the data is written from the copy of the chain the next level keeps in 'prevChain', see
+  * startPendingCheckpoint_inter0(), and the control files once it is complete. */
+ /*!@param[in]  currExponent, currEta, currChain, currLogLikelihoodValues, currLogTargetValues, deferBinaryData.*/
   void   checkpointML                  (double                                          currExponent,                       // input
                                         double                                          currEta,                            // input
                                         const SequenceOfVectors<P_V,P_M>&        currChain,                          // input
                                         const ScalarSequence<double>&            currLogLikelihoodValues,            // input
-                                        const ScalarSequence<double>&            currLogTargetValues);               // input
+                                        const ScalarSequence<double>&            currLogTargetValues,                // input
+                                        bool                                            deferBinaryData);                   // input
+
+ //! Writes a checkpoint control file; called by process 0 only.
+  void   checkpointControl_proc0       (const std::string&                       fileName,                           // input
+                                        unsigned int                                    level,                              // input
+                                        double                                          exponent,                           // input
+                                        double                                          eta,                                // input
+                                        unsigned int                                    chainSize,                          // input
+                                        const std::vector<double>&                      logEvidenceFactors);                // input
+
+ //! Starts writing the binary data of a deferred checkpoint from the previous level's sequences.
+ /*! With C++11 the data is written by a separate thread while the current level runs; the
+  * sequences must then stay unchanged until completePendingCheckpoint_all() or
+  * waitForCheckpointWriter() returns.  Without C++11 the data is written at once. */
+  void   startPendingCheckpoint_inter0 (const SequenceOfVectors<P_V,P_M>&        prevChain,                          // input
+                                        const ScalarSequence<double>&            prevLogLikelihoodValues,            // input
+                                        const ScalarSequence<double>&            prevLogTargetValues);               // input
+
+ //! Waits for the thread writing binary checkpoint data, if any.
+  void   waitForCheckpointWriter       ();
+
+ //! Finishes a deferred checkpoint: waits for its data and writes its control files.
+  void   completePendingCheckpoint_all ();
 
  //! Restarts ML algorithm.
  /*! This method reads the control file and determines the number of lines on it; then it reads the stored
@@ -228,6 +271,29 @@ private:
                                         ScalarSequence<double>&                  currLogLikelihoodValues,            // output
                                         ScalarSequence<double>&                  currLogTargetValues);               // output
 
+ //! Writes the local part of the checkpoint data in binary format.
+ /*! Every inter0 process writes its own file, \c baseName + "Data_l<level>_sub<subId>.bin", straight
+  * from the sequences: a header (magic string, version, number of subenvironments, subId, level,
+  * dimension, chain size, number of position costs) followed by the positions, the log-likelihood
+  * values, the log-target values and the measured position costs as raw doubles. */
+ /*!@param[in]  currChain, currLogLikelihoodValues, currLogTargetValues, level, positionCosts, baseName.*/
+  void   checkpointBinary_inter0       (const SequenceOfVectors<P_V,P_M>&        currChain,                          // input
+                                        const ScalarSequence<double>&            currLogLikelihoodValues,            // input
+                                        const ScalarSequence<double>&            currLogTargetValues,                // input
+                                        unsigned int                                    level,                              // input
+                                        const std::vector<double>&                      positionCosts,                      // input
+                                        const std::string&                       baseName) const;                    // input
+
+ //! Reads the binary checkpoint file of this process' subenvironment.
+ /*! Each process only reads its own partition, so the number of subenvironments must be the one
+  * of the run that wrote the checkpoint. */
+ /*!@param[in]  baseName
+  * @param[out] currChain, currLogLikelihoodValues, currLogTargetValues.*/
+  void   restartBinary_all             (SequenceOfVectors<P_V,P_M>&              currChain,                          // output
+                                        ScalarSequence<double>&                  currLogLikelihoodValues,            // output
+                                        ScalarSequence<double>&                  currLogTargetValues,                // output
+                                        const std::string&                       baseName);                          // input
+
  //! Generates the sequence at the level 0.
  /*! @param[in]  currOptions
   @param[out] unifiedRequestedNumSamples, currChain, currLogLikelihoodValues, currLogTargetValues*/
@@ -452,6 +518,14 @@ private:
   void   justBalance_proc0             (const MLSamplingLevelOptions*            currOptions,                        // input
                                         std::vector<ExchangeInfoStruct>&              exchangeStdVec);                    // input/output
 
+  //! Assigns the linked chains to nodes by decreasing estimated cost, each to the least loaded node.
+  /*! This is the longest processing time first (LPT) heuristic, O(Nc log Nc) and within 4/3 of the
+   *  optimal makespan.
+   *  @param[in] currOptions, exchangeStdVec
+   *  @param[out] exchangeStdVec*/
+  void   lptBalance_proc0              (const MLSamplingLevelOptions*            currOptions,                        // input
+                                        std::vector<ExchangeInfoStruct>&              exchangeStdVec);                    // input/output
+
   /*! @param[in] prevChain, exchangeStdVec, finalNumChainsPerNode, finalNumPositionsPerNode
    *  @param[out] balancedLinkControl*/
   void   mpiExchangePositions_inter0   (const SequenceOfVectors<P_V,P_M>&        prevChain,                          // input
@@ -495,10 +569,31 @@ private:
 
    //! Exponent for debugging.
    double                              m_debugExponent;
+
+   //! Measured run time per position of the previous level chain (local positions; empty if unknown).
+   std::vector<double>                 m_prevPositionCosts;
+
+   //! Measured run time per position of the current level chain (local positions).
+   std::vector<double>                 m_currPositionCosts;
+
 	std::vector<double>                 m_logEvidenceFactors; // restart
         double                              m_logEvidence;
         double                              m_meanLogLikelihood;
         double                              m_eig;
+
+   //! A binary checkpoint whose data is written during the next level (see checkpointML()).
+   bool                                m_checkpointPending;
+   unsigned int                        m_pendingCheckpointLevel;
+   double                              m_pendingCheckpointExponent;
+   double                              m_pendingCheckpointEta;
+   unsigned int                        m_pendingCheckpointSize;
+   std::vector<double>                 m_pendingCheckpointLogEvidenceFactors;
+
+   //! Set by the checkpoint writer thread if writing failed.
+   bool                                m_checkpointWriterFailed;
+#ifdef QUESO_HAVE_CXX11
+   std::thread                         m_checkpointWriter;
+#endif
 };
 
 }  // End namespace QUESO
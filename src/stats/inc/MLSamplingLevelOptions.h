@@ -189,6 +189,10 @@ public:
   std::set<unsigned int>             m_dataOutputAllowedSet;
 
   //! Perform load balancing with chosen algorithm (0 = no balancing).
+  /*! 1 = binary integer program (needs GLPK; falls back to 3 above
+   *  ML_LOAD_BALANCE_MAX_NUM_CHAINS_FOR_BIP chains), 2 = balance the number of
+   *  positions, 3 = greedy longest processing time first on the run time per
+   *  position measured at the previous level. */
   unsigned int                       m_loadBalanceAlgorithmId;
 
   //! Perform load balancing if load unbalancing ratio > threshold.
@@ -114,12 +114,15 @@ public:
   std::string            m_restartOutput_baseNameForFiles;
 
   //! Type of restart output file.
+  /*! With "bin" every subenvironment writes its part of the chain to its own binary file. */
   std::string            m_restartOutput_fileType;
 
   //! Base name of restart input file.
   std::string            m_restartInput_baseNameForFiles;
 
   //! Type of restart input file
+  /*! With "bin" every subenvironment reads its own binary file; the number of
+   *  subenvironments must then be the one of the checkpointed run. */
   std::string            m_restartInput_fileType;
 #else
   //! Name of restart input file.
@@ -33,6 +33,7 @@
 #include <queso/ScalarFunctionSynchronizer.h>
 #include <queso/SequenceOfVectors.h>
 #include <queso/ArrayOfSequences.h>
+#include <queso/FilePtr.h>
 #include <sys/time.h>
 #include <fstream>
 #include <queso/SharedPtr.h>
@@ -45,6 +46,12 @@ class GslMatrix;
 template <class P_V, class P_M>
 class Algorithm;
 
+template <class V, class M>
+class StreamingConvergenceMonitor;
+
+template <class V, class M>
+class OnlineVectorStatistics;
+
 //--------------------------------------------------
 // MHRawChainInfoStruct --------------------------
 //--------------------------------------------------
@@ -106,6 +113,7 @@ struct MHRawChainInfoStruct
   unsigned int numOutOfTargetSupport;
   unsigned int numOutOfTargetSupportInDR;
   unsigned int numRejections;
+  unsigned int numSurrogateRejections;
 
 };
 
@@ -186,6 +194,26 @@ public:
   ~MetropolisHastingsSG();
   //@}
 
+  //! @name Set methods
+  //@{
+  //! Screens the candidates with a cheap approximation of the log-target (delayed acceptance).
+  /*!
+   * A candidate y drawn at position x is first accepted or rejected as if
+   * \c surrogateLogTarget, s, were the log-target.  Only if it passes is the
+   * target pi evaluated, and y is then accepted with probability
+   * min(1, pi(y) s(x) / (pi(x) s(y))).  The chain keeps pi as its
+   * stationary distribution (Christen and Fox, 2005), but the candidates
+   * rejected by the first stage never reach the target.
+   *
+   * \c surrogateLogTarget must be finite wherever the target is positive,
+   * must be evaluable by each process without communication, and must
+   * outlive generateSequence().  Delayed acceptance is not compatible with
+   * delayed rejection nor with prefetching.  See also
+   * MhOptionsValues::m_daCorrectionPeriod.
+   */
+  void setDelayedAcceptanceSurrogate(const BaseScalarFunction<P_V,P_M> & surrogateLogTarget);
+  //@}
+
   //! @name Statistical methods
   //@{
  //! Method to generate the chain.
@@ -280,6 +308,84 @@ private:
       const MarkovChainPositionData<P_V> & currentPositionData,
       MarkovChainPositionData<P_V> & currentCandidateData);
 
+  //! Draws a candidate from the transition kernel at \c position.
+  /*! Candidates out of the target support are redrawn unless they are to be
+   * put in the chain.  Returns true if \c candidate is out of the support. */
+  bool generateCandidate(unsigned int positionId,
+      const P_V & position,
+      P_V & candidate);
+
+  //! Fitted trend of the delayed acceptance surrogate error at \c position.
+  double surrogateCorrection(const P_V & position) const;
+
+  //! Adds the surrogate error \c error at \c position to the correction regression.
+  /*! The linear regression is refitted every m_daCorrectionPeriod points. */
+  void refineSurrogateCorrection(const P_V & position, double error);
+
+  //! Builds and evaluates the tree of speculative candidates from \c position.
+  /*!
+   * Starting at chain position \c positionId, the candidates of the most
+   * likely accept/reject outcomes are drawn, most probable first, with the
+   * running acceptance ratio as the probability of each accept, until every
+   * process of the subenvironment has m_prefetchNumCandidatesPerProc of them
+   * to evaluate.  The tree stops at the next adaptation of the proposal
+   * covariance matrix and at the end of the chain.  Only called on subRank 0.
+   *
+   * Each outcome continues the generator from the state the serial chain
+   * would leave it in: the root from m_prefetchRngState, the other nodes
+   * from copies taken after the candidate and the acceptance uniform of
+   * their parent.  The generator of the environment is returned to its
+   * state on entry.
+   */
+  void prefetch(unsigned int positionId,
+      unsigned int chainSize,
+      const P_V & position);
+
+  //! Evaluates the target at the prefetched candidates on all processes of the subenvironment.
+  /*!
+   * \c candidates holds the candidates one after the other on subRank 0, and
+   * is overwritten on the other processes.  On return \c results holds the
+   * log-target, log-prior and log-likelihood of each candidate.  An empty
+   * \c candidates on subRank 0 releases the other processes; the method then
+   * returns false.
+   */
+  bool evaluatePrefetchedCandidates(std::vector<double> & candidates,
+      std::vector<double> & results);
+
+  //! Prints the latest Brooks-Gelman diagnostics of \c convMonitor.
+  void printConvMonitor(const StreamingConvergenceMonitor<P_V,P_M> & convMonitor) const;
+
+  //! Sizes \c workingChain for the filtered positions of a stream-only chain of \c chainSize positions.
+  /*! Also opens the raw chain files and resets the running accumulators
+   * (see MhOptionsValues::m_filteredChainStreamOnly). */
+  void beginStream(unsigned int chainSize,
+      BaseVectorSequence<P_V,P_M> & workingChain,
+      ScalarSequence<double> * workingLogLikelihoodValues,
+      ScalarSequence<double> * workingLogTargetValues);
+
+  //! Hands raw chain position \c positionId of a stream-only chain over to its consumers.
+  /*! The position is written to the raw chain files, added to the running
+   * accumulators and to the window read by adapt() and, if the filter keeps
+   * it, stored in \c workingChain. */
+  void streamPosition(unsigned int positionId,
+      const MarkovChainPositionData<P_V> & positionData,
+      BaseVectorSequence<P_V,P_M> & workingChain,
+      ScalarSequence<double> * workingLogLikelihoodValues,
+      ScalarSequence<double> * workingLogTargetValues);
+
+  //! Closes the raw chain files of a stream-only chain and prints its running statistics.
+  void endStream(unsigned int chainSize);
+
+  //! True if the filter of a stream-only chain keeps raw chain position \c positionId.
+  bool streamFilterKeeps(unsigned int positionId) const;
+
+  //! Values of raw chain position \c positionId.
+  /*! They are read from \c workingChain or, for stream-only chains, from
+   * the window of the latest positions. */
+  void rawPositionValues(const BaseVectorSequence<P_V,P_M> & workingChain,
+      unsigned int positionId,
+      P_V & values) const;
+
   //! This method reads the chain contents.
   void   readFullChain            (const std::string&                  inputFileName,
                                    const std::string&                  inputFileType,
@@ -343,6 +449,43 @@ private:
   bool m_userDidNotProvideOptions;
 
   unsigned int m_latestDirtyCovMatrixIteration;
+
+  // Tree of speculative candidates (see prefetch()); node 0 is the candidate
+  // of the position at which the tree was built.  An accept follows
+  // m_prefetchAcceptChild when alpha >= 1 and m_prefetchDrawnAcceptChild
+  // when the acceptance uniform was drawn
+  std::vector<typename SharedPtr<MarkovChainPositionData<P_V> >::Type> m_prefetchNodes;
+  std::vector<int> m_prefetchAcceptChild;
+  std::vector<int> m_prefetchDrawnAcceptChild;
+  std::vector<int> m_prefetchRejectChild;
+  int m_prefetchNode;
+
+  // State of the generator before the draws of the current position
+  typename SharedPtr<RngBase>::Type m_prefetchRngState;
+  unsigned int m_prefetchNumRounds;
+  unsigned int m_prefetchNumEvaluations;
+
+  // Delayed acceptance: surrogate of the log-target, normal equations of the
+  // regression of its error on (1, position), and fitted slopes
+  const BaseScalarFunction<P_V,P_M> * m_daSurrogate;
+  std::vector<double> m_daNormalMatrix;
+  std::vector<double> m_daNormalRhs;
+  std::vector<double> m_daCorrection;
+  unsigned int m_daNumPoints;
+
+  // Stream-only chains: filter parameters, window of the latest raw
+  // positions for adapt(), raw chain files and running accumulators
+  unsigned int m_streamFilterInitialPos;
+  unsigned int m_streamFilterSpacing;
+  typename ScopedPtr<SequenceOfVectors<P_V,P_M> >::Type m_streamWindow;
+  FilePtrSetStruct m_streamRawFilePtrSet;
+  FilePtrSetStruct m_streamLogLikelihoodFilePtrSet;
+  FilePtrSetStruct m_streamLogTargetFilePtrSet;
+  typename ScopedPtr<OnlineVectorStatistics<P_V,P_M> >::Type m_streamRawStatistics;
+  typename ScopedPtr<P_V>::Type m_streamMLEposition;
+  typename ScopedPtr<P_V>::Type m_streamMAPposition;
+  double m_streamMLEvalue;
+  double m_streamMAPvalue;
 };
 
 }  // End namespace QUESO
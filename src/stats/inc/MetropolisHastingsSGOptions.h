@@ -74,6 +74,7 @@
 #ifdef QUESO_USES_SEQUENCE_STATISTICAL_OPTIONS
 #define UQ_MH_SG_FILTERED_CHAIN_COMPUTE_STATS_ODV                     0
 #endif
+#define UQ_MH_SG_FILTERED_CHAIN_STREAM_ONLY_ODV                       0
 #define UQ_MH_SG_DISPLAY_CANDIDATES_ODV                               0
 #define UQ_MH_SG_PUT_OUT_OF_BOUNDS_IN_CHAIN_ODV                       1
 #define UQ_MH_SG_TK_USE_LOCAL_HESSIAN_ODV                             0
@@ -99,6 +100,8 @@
 #define UQ_MH_SG_ALGORITHM                                            "logit_random_walk"
 #define UQ_MH_SG_TK                                                   "logit_random_walk"
 #define UQ_MH_SG_UPDATE_INTERVAL                                      1
+#define UQ_MH_SG_PREFETCH_NUM_CANDIDATES_PER_PROC_ODV                 0
+#define UQ_MH_SG_DA_CORRECTION_PERIOD_ODV                             0
 
 #ifndef QUESO_DISABLE_BOOST_PROGRAM_OPTIONS
 namespace boost {
@@ -406,6 +409,24 @@ public:
   bool                               m_filteredChainComputeStats;
 #endif
 
+  //! Toggle to filter the chain as it is generated, without keeping the raw chain.
+  /*!
+   * If true (it requires m_filteredChainGenerate), burn-in and lag are
+   * applied as positions are produced and the working chain only ever
+   * holds the filtered positions.  The raw chain, if
+   * m_rawChainDataOutputFileName is not ".", is written to its file one
+   * position at a time ("m" and "txt" formats only).  Adaptation sees every
+   * position through a window of the latest positions; after a transition
+   * kernel dirties its covariance matrix it adapts over the positions since
+   * then.  The raw chain MLE, MAP and moments are kept by running
+   * accumulators.  The unified raw chain file and the raw chain statistics
+   * of m_rawChainComputeStats are not produced.  Not compatible with
+   * m_rawChainGenerateExtra or with reading the raw chain from a file.
+   *
+   * Default is false
+   */
+  bool                               m_filteredChainStreamOnly;
+
   //! Toggle to tell QUESO whether or not to write proposal (candidate) state to output file.  Default is false
   bool                               m_displayCandidates;
 
@@ -595,7 +616,14 @@ public:
    * there are at least two samples with which to compute the convergence
    * statistic.
    *
-   * Needs at least 2 chains (sub environments) to be computed.
+   * The statistic is accumulated position by position by a
+   * StreamingConvergenceMonitor and combined across chains with a nonblocking
+   * reduction, so a value is printed once every chain has reached the
+   * requested iteration, alongside the largest univariate R-hat and the
+   * smallest batch-means effective sample size.
+   *
+   * Needs at least 2 chains (sub environments) for the scale reduction
+   * factors; with a single chain they are printed as -1.
    *
    * The default is 0
    */
@@ -604,8 +632,7 @@ public:
   //! The lag with which to compute the Brooks-Gelman convergence statistic
   /*!
    * The convergence statistic will be computed from sampler iteration
-   * m_BrooksGelmanLag to sampler iteration
-   * (current_sampler_iteration - m_BrooksGelmanLag).
+   * m_BrooksGelmanLag to the current sampler iteration.
    *
    * The default is 100.
    */
@@ -629,6 +656,35 @@ public:
   //! How often to call the TK's updateTK method.  Default is 1.
   unsigned int m_updateInterval;
 
+  //! Number of speculative candidates each process of a subenvironment evaluates per prefetching round.
+  /*!
+   * If positive, the processes of each subenvironment evaluate, concurrently,
+   * the candidates of the most likely future chain positions (the binary
+   * tree of accept/reject outcomes), instead of taking part in one
+   * likelihood evaluation at a time.  The likelihood must then be
+   * evaluable by a single process.  The chain is the one obtained without
+   * prefetching, for any number of processes.  Needs a generator that can
+   * be copied (env_rngType gsl or cxx11).  Not compatible with delayed
+   * rejection.
+   *
+   * The default is 0 (no prefetching).
+   */
+  unsigned int m_prefetchNumCandidatesPerProc;
+
+  //! Number of full target evaluations between two refits of the delayed acceptance correction.
+  /*!
+   * Only used when a surrogate log-target has been given with
+   * MetropolisHastingsSG::setDelayedAcceptanceSurrogate().  If positive, the
+   * differences between the full and the surrogate log-targets at the
+   * candidates that reached the full model are regressed linearly on the
+   * candidate, and the fitted trend is added to the surrogate of the first
+   * stage.  This removes a tilt of a biased surrogate, e.g. a shifted mode,
+   * so that fewer good candidates are screened out.
+   *
+   * The default is 0 (the surrogate is used as given).
+   */
+  unsigned int m_daCorrectionPeriod;
+
 private:
   // Cache a pointer to the environment.
   const BaseEnvironment * m_env;
@@ -703,6 +759,8 @@ private:
   //! Option name for MhOptionsValues::m_filteredChainComputeStats.  Option name is m_prefix + "mh_filteredChain_computeStats"
   std::string                   m_option_filteredChain_computeStats;
 #endif
+  //! Option name for MhOptionsValues::m_filteredChainStreamOnly.  Option name is m_prefix + "mh_filteredChain_streamOnly"
+  std::string                   m_option_filteredChain_streamOnly;
   //! Option name for MhOptionsValues::m_displayCandidates.  Option name is m_prefix + "mh_displayCandidates"
   std::string                   m_option_displayCandidates;
   //! Option name for MhOptionsValues::m_putOutOfBoundsInChain.  Option name is m_prefix + "mh_putOutOfBoundsInChain"
@@ -756,6 +814,10 @@ private:
   std::string                   m_option_tk;
   //! Option name for MhOptionsValues::m_updateInterval.  Option name is m_prefix + "mh_updateInterval"
   std::string                   m_option_updateInterval;
+  //! Option name for MhOptionsValues::m_prefetchNumCandidatesPerProc.  Option name is m_prefix + "mh_prefetchNumCandidatesPerProc"
+  std::string                   m_option_prefetchNumCandidatesPerProc;
+  //! Option name for MhOptionsValues::m_daCorrectionPeriod.  Option name is m_prefix + "mh_daCorrectionPeriod"
+  std::string                   m_option_daCorrectionPeriod;
 
   //! Copies the option values from \c src to \c this.
   void copy(const MhOptionsValues& src);
@@ -29,6 +29,15 @@
 #include <queso/VectorFunction.h>
 #include <queso/VectorFunctionSynchronizer.h>
 #include <queso/MonteCarloSGOptions.h>
+#include <queso/OnlineVectorStatistics.h>
+
+#include <vector>
+
+//! Number of positions between flushes of the raw sequences in generateStatistics(), if no output period is set.
+#define UQ_MOC_SG_STREAMING_CHUNK_SIZE 1000
+
+//! Number of initial samples that set the histogram ranges in generateStatistics().
+#define UQ_MOC_SG_STREAMING_PILOT_SIZE 1000
 
 namespace QUESO {
 
@@ -77,6 +86,18 @@ public:
    * interest (QoI).*/
   void generateSequence(BaseVectorSequence<P_V,P_M>& workingPSeq,
                         BaseVectorSequence<Q_V,Q_M>& workingQSeq);
+
+  //! Generates the samples without storing them, accumulating their statistics only.
+  /*! Draws as many samples as generateSequence() would and feeds every parameter and QoI
+   * vector to \c pStats and \c qStats, so memory does not depend on the number of samples.
+   * If the options name a pseq / qseq output file, the raw samples are streamed to it, as
+   * one sequence of qseq_size positions in the 'm' or 'txt' format, and flushed every
+   * pseq / qseq_dataOutputPeriod positions (UQ_MOC_SG_STREAMING_CHUNK_SIZE if the period
+   * is 0).  Histograms without a range get one from the first
+   * UQ_MOC_SG_STREAMING_PILOT_SIZE samples of all the subenvironments.  On return the
+   * statistics of all subenvironments are merged and available on every inter0 process. */
+  void generateStatistics(OnlineVectorStatistics<P_V,P_M>& pStats,
+                          OnlineVectorStatistics<Q_V,Q_M>& qStats);
   //@}
 
   //! @name I/O methods
@@ -113,6 +134,26 @@ private:
                                     BaseVectorSequence<P_V,P_M>& workingPSeq,
                                     BaseVectorSequence<Q_V,Q_M>& workingQSeq,
                                     unsigned int                        seqSize);
+  //! Sets the histogram range of \c stats from the pilot samples \c pilotValues of all subenvironments.
+  template <class V, class M>
+  void setHistogramRangeFromPilot(OnlineVectorStatistics<V,M>& stats,
+                                  const VectorSpace<V,M>&      vectorSpace,
+                                  const std::vector<double>&   pilotValues) const;
+
+  //! Opens \c fileName, unless it is UQ_MOC_SG_FILENAME_FOR_NO_FILE, and writes the header of a sequence of \c numPos positions.
+  template <class V, class M>
+  void openStreamedSequenceFile(const std::string&            fileName,
+                                const std::string&            fileType,
+                                const std::set<unsigned int>& allowedSubEnvIds,
+                                const std::string&            sequenceName,
+                                unsigned int                  numPos,
+                                const VectorSpace<V,M>&       vectorSpace,
+                                FilePtrSetStruct&             filePtrSet) const;
+
+  //! Writes one position of a streamed sequence.
+  template <class V>
+  static void writeStreamedPosition(std::ofstream& ofs, const V& values);
+
   //! Reads the sequence.
   void actualReadSequence    (const BaseVectorRV      <P_V,P_M>& paramRv,
                               const std::string&                        dataInputFileName,
@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_ONLINE_VECTOR_STATISTICS_H
+#define UQ_ONLINE_VECTOR_STATISTICS_H
+
+#include <queso/Environment.h>
+#include <queso/VectorSpace.h>
+#include <queso/QuantileSketch.h>
+
+#include <ostream>
+#include <vector>
+
+//! Default number of bins of the histograms of OnlineVectorStatistics.
+#define UQ_ONLINE_VECTOR_STATISTICS_NUM_BINS_ODV 50
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file OnlineVectorStatistics.h
+    \brief Constant-memory statistics of a stream of vectors
+*/
+
+/*! \class OnlineVectorStatistics
+ *  \brief Moments, covariances, histograms and quantiles of a stream of vectors.
+ *
+ * Positions are added one at a time by append() and are not stored.  The
+ * object keeps
+ *  - the mean and the second, third and fourth central moments of every
+ *    component (Pebay's one-pass updates),
+ *  - the packed co-moment matrix (Welford's update, O(d^2) per position),
+ *  - the exact minimum and maximum of every component,
+ *  - a fixed-bin histogram of every component, once setHistogramRange() has
+ *    been called (values outside the range are counted in the edge bins),
+ *  - a QuantileSketch of every component.
+ * Memory is O(d^2 + d (numBins + k)) whatever the number of positions.
+ *
+ * Two objects over the same vector space and histogram ranges merge exactly
+ * (Pebay's pairwise formulas); unifiedReduce() merges the statistics of all
+ * the subenvironments over inter0Comm.  Only processes with an inter0 rank
+ * accumulate anything.
+ */
+template <class V = GslVector, class M = GslMatrix>
+class OnlineVectorStatistics
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor.
+  /*! \c numBins is the number of bins of each histogram (0 disables the
+   * histograms) and \c sketchSize the parameter k of the quantile sketches. */
+  OnlineVectorStatistics(const VectorSpace<V, M> & vectorSpace,
+                         unsigned int numBins = UQ_ONLINE_VECTOR_STATISTICS_NUM_BINS_ODV,
+                         unsigned int sketchSize = UQ_QUANTILE_SKETCH_K_ODV);
+
+  //! Destructor.
+  ~OnlineVectorStatistics();
+  //@}
+
+  //! @name Accumulation methods
+  //@{
+  //! Sets the histogram ranges; must be called before the first append().
+  void setHistogramRange(const V & minValues, const V & maxValues);
+
+  //! True if histograms are enabled and their range is set.
+  bool hasHistogramRange() const;
+
+  //! Number of histogram bins per component.
+  unsigned int numBins() const;
+
+  //! Adds one position.
+  void append(const V & position);
+
+  //! Adds the statistics of \c other.
+  void merge(const OnlineVectorStatistics<V, M> & other);
+
+  //! Merges the statistics of all subenvironments; every inter0 process gets the result.
+  void unifiedReduce();
+  //@}
+
+  //! @name Result methods
+  //@{
+  //! Number of positions.
+  double numPositions() const;
+
+  //! Mean of every component.
+  void mean(V & values) const;
+
+  //! Sample variance (divided by n - 1) of every component.
+  void variance(V & values) const;
+
+  //! Skewness of every component.
+  void skewness(V & values) const;
+
+  //! Excess kurtosis of every component.
+  void kurtosis(V & values) const;
+
+  //! Smallest value of every component.
+  void minValues(V & values) const;
+
+  //! Largest value of every component.
+  void maxValues(V & values) const;
+
+  //! Sample covariance matrix (divided by n - 1).
+  void covMatrix(M & matrix) const;
+
+  //! Correlation matrix.
+  void corrMatrix(M & matrix) const;
+
+  //! Approximate quantile \c fraction of component \c i.
+  double quantile(unsigned int i, double fraction) const;
+
+  //! Bin centers and counts of the histogram of component \c i.
+  void histogram(unsigned int i,
+                 std::vector<double> & binCenters,
+                 std::vector<double> & binCounts) const;
+
+  //! Prints the moments and a few quantiles of every component.
+  void print(std::ostream & os) const;
+  //@}
+
+private:
+  //! Index of (i,j), i <= j, in the packed upper triangle.
+  unsigned int packedIndex(unsigned int i, unsigned int j) const;
+
+  //! Appends all the statistics to \c buffer.
+  void pack(std::vector<double> & buffer) const;
+
+  //! Replaces the statistics by the ones packed in \c buffer at \c offset.
+  void unpack(const std::vector<double> & buffer, unsigned int & offset);
+
+  const BaseEnvironment & m_env;
+  const VectorSpace<V, M> & m_vectorSpace;
+  unsigned int m_dim;
+  bool m_participates;
+
+  // Central moment accumulators
+  double m_n;
+  std::vector<double> m_mean;
+  std::vector<double> m_m2;
+  std::vector<double> m_m3;
+  std::vector<double> m_m4;
+  std::vector<double> m_delta;
+  std::vector<double> m_comoment;   // packed upper triangle
+  std::vector<double> m_min;
+  std::vector<double> m_max;
+
+  // Histograms, row-major, one row of m_numBins counts per component
+  unsigned int m_numBins;
+  bool m_hasHistogramRange;
+  std::vector<double> m_histMin;
+  std::vector<double> m_histMax;
+  std::vector<double> m_histCounts;
+
+  std::vector<QuantileSketch> m_sketches;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_ONLINE_VECTOR_STATISTICS_H
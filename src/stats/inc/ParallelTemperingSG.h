@@ -0,0 +1,223 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_PARALLEL_TEMPERING_SG_H
+#define UQ_PARALLEL_TEMPERING_SG_H
+
+#include <queso/MetropolisHastingsSGOptions.h>
+#include <queso/BayesianJointPdf.h>
+#include <queso/ScalarFunctionSynchronizer.h>
+#include <queso/VectorRV.h>
+#include <queso/VectorSequence.h>
+#include <queso/ScalarSequence.h>
+#include <queso/ScopedPtr.h>
+#include <queso/RngBase.h>
+
+#include <vector>
+
+#define UQ_PT_SG_MAX_TEMPERATURE_ODV           100.
+#define UQ_PT_SG_SWAP_PERIOD_ODV               10
+#define UQ_PT_SG_LADDER_ADAPTATION_PERIOD_ODV  10
+#define UQ_PT_SG_ADAPTATION_LENGTH_ODV         0
+
+//! Target acceptance ratio of the within-chain random walk during adaptation.
+#define UQ_PT_SG_TARGET_ACCEPTANCE_RATIO       0.234
+
+//! MPI tag of the swap messages exchanged over inter0Comm.
+#define UQ_PT_SG_SWAP_MSG_TAG                  7301
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file ParallelTemperingSG.h
+    \brief Replica-exchange (parallel tempering) sequence generator
+*/
+
+/*! \class ParallelTemperingSG
+ *  \brief Runs one tempered chain per subenvironment and swaps states between neighbours.
+ *
+ * Subenvironment k (its rank in inter0Comm) runs a random walk Metropolis
+ * chain on the BayesianJointPdf of the prior and likelihood, with likelihood
+ * exponent (inverse temperature) beta_k.  beta_0 = 1, so subenvironment 0
+ * samples the posterior; the other chains sample flatter distributions and
+ * let it hop between modes it would otherwise never leave.
+ *
+ * Every swapPeriod() positions each chain proposes to swap its state with one
+ * neighbour, alternating between the even and the odd pairs of the ladder, so
+ * every chain takes part in at most one exchange per round.  A swap costs two
+ * point-to-point messages of dim + 3 doubles between the two inter0 processes;
+ * no other chain waits.
+ *
+ * During the first adaptationLength() positions
+ *  - the temperatures between 1 and maxTemperature() are moved every
+ *    ladderAdaptationPeriod() swap rounds so that all neighbouring pairs reach
+ *    the same swap acceptance rate (this is the only collective operation), and
+ *  - the random walk step of each chain is scaled towards an acceptance
+ *    ratio of UQ_PT_SG_TARGET_ACCEPTANCE_RATIO.
+ * Afterwards the ladder and the proposals are frozen.
+ *
+ * The chain size and the raw chain output file are taken from the usual
+ * MhOptionsValues.  The working chain of every subenvironment holds the
+ * positions of its own temperature; only subenvironment 0 holds posterior
+ * samples.  The log-likelihood values are untempered, the log-target values
+ * are those of each chain's tempered target.
+ *
+ * As in MetropolisHastingsSG, the processes of a subenvironment other than
+ * its subRank 0 only take part in the (possibly parallel) evaluation of the
+ * likelihood.
+ *
+ * Each chain draws from its own GSL generator, seeded with the seed of the
+ * environment's generator plus 1 plus the chain id, so the chains do not
+ * share random numbers even when all the processes have the same seed.
+ */
+template <class P_V = GslVector, class P_M = GslMatrix>
+class ParallelTemperingSG
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor.
+  /*! If \c alternativeOptionsValues is NULL the Metropolis-Hastings options
+   * are read from the input file with prefix \c prefix.  If
+   * \c inputProposalCovMatrix is NULL the prior covariance is used.  The
+   * proposal step of the chain at temperature T is scaled by sqrt(T), i.e.
+   * its covariance by T. */
+  ParallelTemperingSG(const char*                         prefix,
+                      const MhOptionsValues*              alternativeOptionsValues,
+                      const BaseVectorRV<P_V,P_M>&        priorRv,
+                      const BaseScalarFunction<P_V,P_M>&  likelihoodFunction,
+                      const P_V&                          initialPosition,
+                      const P_M*                          inputProposalCovMatrix);
+
+  //! Destructor
+  ~ParallelTemperingSG();
+  //@}
+
+  //! @name Set methods
+  //@{
+  //! Temperature of the hottest chain; the ladder starts out geometric between 1 and it.
+  void setMaxTemperature(double maxTemperature);
+
+  //! Number of chain positions between two swap rounds.
+  void setSwapPeriod(unsigned int swapPeriod);
+
+  //! Number of swap rounds between two adaptations of the ladder.
+  void setLadderAdaptationPeriod(unsigned int ladderAdaptationPeriod);
+
+  //! Number of initial positions during which the ladder and the proposals adapt.
+  /*! 0 (the default) means half of the raw chain. */
+  void setAdaptationLength(unsigned int adaptationLength);
+  //@}
+
+  //! @name Statistical methods
+  //@{
+  //! Generates this subenvironment's chain; must be called on all processes.
+  void generateSequence(BaseVectorSequence<P_V,P_M>& workingChain,
+                        ScalarSequence<double>*      workingLogLikelihoodValues,
+                        ScalarSequence<double>*      workingLogTargetValues);
+  //@}
+
+  //! @name Access methods
+  //@{
+  //! Number of chains in the ladder, i.e. of subenvironments.
+  unsigned int numTemperatures() const;
+
+  //! Current (final, after generateSequence()) temperature of chain \c k.
+  double temperature(unsigned int k) const;
+
+  //! Fraction of accepted swaps between chains \c k and \c k+1 after adaptation.
+  double swapAcceptanceRatio(unsigned int k) const;
+
+  //! Fraction of accepted within-chain moves on this subenvironment.
+  double acceptanceRatio() const;
+
+  //! Prints the ladder and the acceptance ratios.
+  void print(std::ostream& os) const;
+  //@}
+
+private:
+  //! Sets the ladder geometric between 1 and m_maxTemperature.
+  void initializeLadder();
+
+  //! One random walk step at this chain's temperature; returns true if accepted.
+  bool metropolisStep(unsigned int positionId, bool adapt);
+
+  //! Proposes a swap with one neighbour; \c round decides the pairing.
+  void swapRound(unsigned int round, bool adapt);
+
+  //! Moves the interior temperatures towards uniform swap acceptance rates.
+  void adaptLadder();
+
+  //! Log target of the current state at this chain's temperature.
+  double currentLogTarget() const;
+
+  const BaseEnvironment&                   m_env;
+  const VectorSpace<P_V,P_M>&              m_vectorSpace;
+  const BaseVectorRV<P_V,P_M>&             m_priorRv;
+  const BaseScalarFunction<P_V,P_M>&       m_likelihoodFunction;
+
+  ScopedPtr<MhOptionsValues>::Type                                m_optionsObj;
+  typename ScopedPtr<VectorSet<P_V,P_M> >::Type                   m_targetDomain;
+  typename ScopedPtr<BayesianJointPdf<P_V,P_M> >::Type            m_targetPdf;
+  typename ScopedPtr<ScalarFunctionSynchronizer<P_V,P_M> >::Type  m_targetPdfSynchronizer;
+
+  P_V                 m_initialPosition;
+  P_M                 m_proposalCholFactor;
+
+  double              m_maxTemperature;
+  unsigned int        m_swapPeriod;
+  unsigned int        m_ladderAdaptationPeriod;
+  unsigned int        m_adaptationLength;
+
+  unsigned int        m_numChains;
+  int                 m_chainId;
+  std::vector<double> m_temperatures;
+  unsigned int        m_numLadderAdaptations;
+
+  // Swap counters of the pair (k,k+1), kept by chain k
+  std::vector<double> m_windowSwapAttempts;
+  std::vector<double> m_windowSwapAccepts;
+  std::vector<double> m_swapAttempts;
+  std::vector<double> m_swapAccepts;
+
+  // Current state of this chain
+  P_V                 m_position;
+  P_V                 m_proposal;
+  P_V                 m_gaussian;
+  P_V                 m_step;
+  double              m_logPrior;
+  double              m_logLikelihood;
+  double              m_logScale;
+  unsigned int        m_numProposed;
+  unsigned int        m_numAccepted;
+
+  // Random numbers of this chain only; set up by generateSequence()
+  ScopedPtr<RngBase>::Type m_rng;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_PARALLEL_TEMPERING_SG_H
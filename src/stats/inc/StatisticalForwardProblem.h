@@ -32,6 +32,8 @@
 #include <queso/GenericVectorRV.h>
 #include <queso/SequenceOfVectors.h>
 
+#include <vector>
+
 namespace QUESO {
 
 class GslVector;
@@ -121,6 +123,34 @@ public:
 //<item> computes the CDFs of the components of 'm_qoiRv' as instances of 'SampledVectorCdf<Q_V,Q_M>'
   void                                   solveWithMonteCarlo(const McOptionsValues* alternativeOptionsValues); // dakota
 
+  //! Computes the first-order and total Sobol indices of every QoI component (Saltelli design).
+  /*! Two independent samples A and B of \c numSamples rows are drawn from the parameter RV.  For
+   * every row the QoI function is evaluated at A, at B and at the d points AB_j (A with its j-th
+   * component taken from B), i.e. (d+2) numSamples evaluations in total.  The rows are dealt out
+   * round-robin over the subenvironments and the estimators are accumulated on the fly, so no
+   * sample matrix is stored.  First-order indices use the estimator of Saltelli et al. (2010),
+   * total indices the one of Jansen (1999).  The bounds of the confidence intervals at level
+   * \c confidenceLevel are percentiles of \c numBootstrapSamples Poisson bootstrap replicates,
+   * accumulated in the same pass.  Must be called on all processes; the indices are then
+   * available on all of them. */
+  void                                   solveWithSobolIndices(unsigned int numSamples,
+                                                               unsigned int numBootstrapSamples,
+                                                               double       confidenceLevel);
+
+  //! First-order Sobol index of parameter \c paramId for QoI component \c qoiId.
+  double                                 sobolFirstOrderIndex(unsigned int paramId, unsigned int qoiId) const;
+
+  //! Total Sobol index of parameter \c paramId for QoI component \c qoiId.
+  double                                 sobolTotalIndex     (unsigned int paramId, unsigned int qoiId) const;
+
+  //! Bootstrap confidence interval of sobolFirstOrderIndex().
+  void                                   sobolFirstOrderIndexInterval(unsigned int paramId, unsigned int qoiId,
+                                                                      double& lower, double& upper) const;
+
+  //! Bootstrap confidence interval of sobolTotalIndex().
+  void                                   sobolTotalIndexInterval     (unsigned int paramId, unsigned int qoiId,
+                                                                      double& lower, double& upper) const;
+
   //! Returns the QoI RV; access to private attribute m_qoiRv.
   const GenericVectorRV<Q_V,Q_M>& qoiRv              () const;
 
@@ -153,6 +183,11 @@ private:
   /*! \todo: implement me!*/
   void  commonConstructor();
 
+  //! Sobol indices, indexed by qoiId * dim + paramId, from the sums of one bootstrap replicate.
+  void  computeSobolIndices(const double*        sums,
+                            std::vector<double>& firstOrder,
+                            std::vector<double>& total) const;
+
   const BaseEnvironment&                     m_env;
 
   const BaseVectorRV      <P_V,P_M>&         m_paramRv;
@@ -185,6 +220,14 @@ private:
 #endif
 
   bool m_userDidNotProvideOptions;
+
+  // Sobol indices and their bounds, indexed by qoiId * dim + paramId
+  std::vector<double> m_sobolFirstOrder;
+  std::vector<double> m_sobolFirstOrderLower;
+  std::vector<double> m_sobolFirstOrderUpper;
+  std::vector<double> m_sobolTotal;
+  std::vector<double> m_sobolTotalLower;
+  std::vector<double> m_sobolTotalUpper;
 };
 
 }  // End namespace QUESO
@@ -28,6 +28,8 @@
 #include <queso/StatisticalInverseProblemOptions.h>
 #include <queso/MetropolisHastingsSG.h>
 #include <queso/MLSampling.h>
+#include <queso/ParallelTemperingSG.h>
+#include <queso/EnsembleSamplerSG.h>
 #include <queso/InstantiateIntersection.h>
 #include <queso/VectorRealizer.h>
 #include <queso/SequentialVectorRealizer.h>
@@ -214,9 +216,42 @@ public:
    */
   void seedWithMAPEstimator();
 
+  //! Screens the Metropolis-Hastings candidates with a cheap surrogate of the likelihood
+  /*!
+   * \c surrogateLikelihood, e.g. an interpolation surrogate or an emulator
+   * of the likelihood, is combined with the prior into the first stage of
+   * delayed acceptance, see
+   * MetropolisHastingsSG::setDelayedAcceptanceSurrogate().  The likelihood
+   * is then only evaluated at the candidates that pass the first stage,
+   * and the chain still samples the exact posterior.  \c surrogateLikelihood
+   * must outlive solveWithBayesMetropolisHastings().
+   */
+  void setDelayedAcceptanceSurrogate(const BaseScalarFunction<P_V,P_M> & surrogateLikelihood);
+
   //! Solves with Bayes Multi-Level (ML) sampling.
   void                             solveWithBayesMLSampling        ();
 
+  //! Solves the problem via Bayes formula and parallel tempering.
+  /*!
+   * Each subenvironment runs a chain at its own temperature, see
+   * ParallelTemperingSG.  Chain size and output files are taken from the
+   * Metropolis-Hastings options.  The chain, and hence the realizer of
+   * 'm_postRv', only holds posterior samples on subenvironment 0.
+   */
+  void solveWithBayesParallelTempering(const MhOptionsValues* alternativeOptionsValues,
+                                       const P_V&             initialValues,
+                                       const P_M*             initialProposalCovMatrix);
+
+  //! Solves the problem via Bayes formula and an affine-invariant ensemble sampler.
+  /*!
+   * See EnsembleSamplerSG.  The walkers start around 'initialValues' with
+   * covariance 'initialCovMatrix' or, if it is NULL, as prior draws.  Every
+   * process of the full communicator evaluates the likelihood on its own.
+   */
+  void solveWithBayesEnsembleSampler(const MhOptionsValues* alternativeOptionsValues,
+                                     const P_V&             initialValues,
+                                     const P_M*             initialCovMatrix);
+
   //! Return the underlying MetropolisHastingSG object
   const MetropolisHastingsSG<P_V, P_M> & sequenceGenerator() const;
 
@@ -269,12 +304,15 @@ private:
 
   typename ScopedPtr<VectorSet           <P_V,P_M> >::Type m_solutionDomain;
   typename ScopedPtr<BaseJointPdf        <P_V,P_M> >::Type m_solutionPdf;
+  typename ScopedPtr<BaseJointPdf        <P_V,P_M> >::Type m_surrogatePdf;
   typename ScopedPtr<BaseVectorMdf       <P_V,P_M> >::Type m_subSolutionMdf;
   typename ScopedPtr<BaseVectorCdf       <P_V,P_M> >::Type m_subSolutionCdf;
   typename ScopedPtr<BaseVectorRealizer  <P_V,P_M> >::Type m_solutionRealizer;
 
   typename ScopedPtr<MetropolisHastingsSG<P_V,P_M> >::Type m_mhSeqGenerator;
   typename ScopedPtr<MLSampling          <P_V,P_M> >::Type m_mlSampler;
+  typename ScopedPtr<ParallelTemperingSG <P_V,P_M> >::Type m_ptSeqGenerator;
+  typename ScopedPtr<EnsembleSamplerSG   <P_V,P_M> >::Type m_ensembleSeqGenerator;
   typename ScopedPtr<BaseVectorSequence  <P_V,P_M> >::Type m_chain;
   ScopedPtr<ScalarSequence<double> >::Type m_logLikelihoodValues;
   ScopedPtr<ScalarSequence<double> >::Type m_logTargetValues;
@@ -283,6 +321,8 @@ private:
 
   bool m_seedWithMAPEstimator;
 
+  const BaseScalarFunction<P_V,P_M> * m_surrogateLikelihood;
+
 #ifdef UQ_ALSO_COMPUTE_MDFS_WITHOUT_KDE
   typename ScopedPtr<ArrayOfOneDGrids    <P_V,P_M> > m_subMdfGrids;
   typename ScopedPtr<ArrayOfOneDTables   <P_V,P_M> > m_subMdfValues;
@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_STREAMING_CONVERGENCE_MONITOR_H
+#define UQ_STREAMING_CONVERGENCE_MONITOR_H
+
+#include <queso/Environment.h>
+#include <queso/MpiComm.h>
+#include <queso/VectorSpace.h>
+
+#include <deque>
+#include <vector>
+
+//! Number of batches kept by the batch-means ESS estimator before pairs are merged.
+#define UQ_STREAMING_CONV_MONITOR_NUM_BATCHES 32
+
+namespace QUESO {
+
+class GslVector;
+class GslMatrix;
+
+/*! \file StreamingConvergenceMonitor.h
+    \brief Online multi-chain convergence diagnostics
+*/
+
+/*! \class StreamingConvergenceMonitor
+ *  \brief Brooks-Gelman and batch-means diagnostics updated one position at a time.
+ *
+ * Each chain (subenvironment) feeds its positions through append().  The
+ * monitor keeps the running mean and covariance of the chain (Welford's
+ * update, O(d^2) per position) together with the sums of a batch-means
+ * estimator whose batch size doubles whenever
+ * UQ_STREAMING_CONV_MONITOR_NUM_BATCHES * 2 batches are full, so the work and
+ * memory never depend on the chain length.
+ *
+ * snapshot() packs these per-chain statistics and starts a nonblocking sum
+ * over inter0Comm; the sampler keeps going and the reduction is harvested by
+ * poll() or a later snapshot() once every chain has contributed.  All chains
+ * must call snapshot() the same number of times, but no chain ever waits for
+ * another one except in finish().  Each completed reduction yields, for the
+ * positions seen up to the snapshot,
+ *  - the multivariate potential scale reduction factor of Brooks and Gelman
+ *    (the same quantity as SequenceOfVectors::estimateConvBrooksGelman()),
+ *  - the univariate R-hat of every component,
+ *  - the batch-means effective sample size of every component, summed over
+ *    the chains.
+ *
+ * R-hat needs at least two chains; with a single chain only the ESS is
+ * available and the scale reduction factors are reported as -1.
+ */
+template <class V = GslVector, class M = GslMatrix>
+class StreamingConvergenceMonitor
+{
+public:
+  //! @name Constructor/Destructor methods
+  //@{
+  //! Constructor.
+  StreamingConvergenceMonitor(const BaseEnvironment & env,
+                              const VectorSpace<V, M> & vectorSpace);
+
+  //! Destructor.  Waits for any pending reduction.
+  ~StreamingConvergenceMonitor();
+  //@}
+
+  //! @name Accumulation methods
+  //@{
+  //! Adds one chain position to the running statistics of this chain.
+  void append(const V & position);
+
+  //! Number of positions appended so far on this chain.
+  unsigned int numPositions() const;
+
+  //! Starts a nonblocking combination of the current statistics across chains.
+  /*! \c tag identifies the snapshot in the results (typically the chain
+   * position id).  Completed earlier reductions are harvested first. */
+  void snapshot(unsigned int tag);
+
+  //! Harvests every reduction that has completed, without blocking.
+  /*! Returns the number of new results. */
+  unsigned int poll();
+
+  //! Blocks until every pending reduction has completed.
+  /*! Returns the number of new results. */
+  unsigned int finish();
+  //@}
+
+  //! @name Result methods
+  //@{
+  //! True once at least one reduction has completed.
+  bool hasResult() const;
+
+  //! Tag of the snapshot the latest results refer to.
+  unsigned int resultTag() const;
+
+  //! Multivariate potential scale reduction factor of the latest result.
+  double mpsrf() const;
+
+  //! Largest univariate R-hat of the latest result.
+  double maxRhat() const;
+
+  //! Univariate R-hat of every component of the latest result.
+  const std::vector<double> & rhat() const;
+
+  //! Effective sample size of every component, summed over the chains.
+  const std::vector<double> & ess() const;
+  //@}
+
+private:
+  //! Reduction buffers must not move while the reduction is in flight.
+  struct PendingReduction
+  {
+    unsigned int        tag;
+    std::vector<double> sendBuf;
+    std::vector<double> recvBuf;
+    RawType_MPI_Request request;
+  };
+
+  //! Index of (i,j), i <= j, in the packed upper triangle.
+  unsigned int packedIndex(unsigned int i, unsigned int j) const;
+
+  //! Fills \c buf with this chain's contribution to a reduction.
+  void pack(std::vector<double> & buf) const;
+
+  //! Computes the diagnostics from a completed reduction.
+  void unpack(const PendingReduction & pending);
+
+  //! Merges adjacent batches pairwise and doubles the batch size.
+  void mergeBatches();
+
+  const BaseEnvironment & m_env;
+  const VectorSpace<V, M> & m_vectorSpace;
+  unsigned int m_dim;
+  bool m_participates;
+
+  // Welford accumulators
+  unsigned int m_n;
+  std::vector<double> m_mean;
+  std::vector<double> m_delta;
+  std::vector<double> m_comoment;   // packed upper triangle
+
+  // Batch-means accumulators
+  unsigned int m_batchSize;
+  unsigned int m_currentBatchCount;
+  std::vector<double> m_currentBatchSum;
+  std::vector<double> m_batchMeans;  // row-major, one row per full batch
+  unsigned int m_numBatches;
+
+  std::deque<PendingReduction *> m_pending;
+
+  bool m_hasResult;
+  unsigned int m_resultTag;
+  double m_mpsrf;
+  double m_maxRhat;
+  std::vector<double> m_rhat;
+  std::vector<double> m_ess;
+};
+
+}  // End namespace QUESO
+
+#endif // UQ_STREAMING_CONVERGENCE_MONITOR_H
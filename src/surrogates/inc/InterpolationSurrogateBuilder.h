@@ -28,6 +28,10 @@
 #include <queso/SurrogateBuilderBase.h>
 #include <queso/InterpolationSurrogateDataSet.h>
 
+// C++
+#include <fstream>
+#include <string>
+
 namespace QUESO
 {
   class GslVector;
@@ -38,7 +42,21 @@ namespace QUESO
       and the number of equally space points desired in each dimension, this
       class will handle calling the user's model to populate the values needed
       by the surrogate objects. User should subclass this object and implement
-      the evaluate_model method. */
+      the evaluate_model method.
+
+      By default, the grid is split statically into contiguous blocks, one per
+      subenvironment. If the model cost varies strongly over the domain, call
+      set_work_chunk_size() so that subenvironments instead pull chunks of
+      points from a work queue as they become idle. The queue is served by
+      inter0 rank 0, which also evaluates points itself: it only answers
+      requests in between two of its own calls to evaluate_model(), so an
+      idle subenvironment may wait up to one model evaluation of that rank
+      for its next chunk. The dispatcher does not run in a thread of its own
+      because that would require MPI_THREAD_MULTIPLE from the user's MPI
+      initialization. Calling
+      set_checkpoint_prefix() additionally appends every evaluated point to a
+      per-subenvironment file as soon as it is computed; a later build_values()
+      with the same prefix reloads those points and only evaluates the rest. */
   template<class V = GslVector, class M = GslMatrix>
   class InterpolationSurrogateBuilder : public SurrogateBuilderBase<V>
   {
@@ -54,6 +72,18 @@ namespace QUESO
     //! Execute the user's model and populate m_values for the given n_points
     void build_values();
 
+    //! Use a dynamic work queue handing out \c chunk_size points at a time
+    /*! A value of 0 (the default) restores the static partition. Requests
+        wait for the current model evaluation of the dispatcher (see the
+        class documentation), so a chunk should take several evaluations. */
+    void set_work_chunk_size( unsigned int chunk_size )
+    { m_work_chunk_size = chunk_size; };
+
+    //! Checkpoint evaluated points to files prefix_sub<id>.bin and restart from them
+    /*! An empty prefix (the default) disables checkpointing. */
+    void set_checkpoint_prefix( const std::string& prefix )
+    { m_checkpoint_prefix = prefix; };
+
   protected:
 
     InterpolationSurrogateDataSet<V,M>& m_data;
@@ -61,6 +91,12 @@ namespace QUESO
     //! Cache the amount of work for each subenvironment
     std::vector<int> m_njobs;
 
+    //! Number of points per work queue request; 0 means static partitioning
+    unsigned int m_work_chunk_size;
+
+    //! Filename prefix for incremental checkpoints; empty means none
+    std::string m_checkpoint_prefix;
+
     //! Partition the workload of model evaluations across the subenvironments
     void partition_work();
 
@@ -83,6 +119,43 @@ namespace QUESO
     //! Helper function to compute strides needed for MPI_Gatherv
     void compute_strides( std::vector<int>& strides ) const;
 
+    //! Helper function to compute strides for arbitrary per-subenvironment counts
+    void compute_strides( const std::vector<int>& counts,
+                          std::vector<int>& strides ) const;
+
+    //! Evaluate the model at the points handed out by the work queue
+    /*! Only indices listed in \c todo are evaluated. The inter0 rank 0 acts
+        as dispatcher in between its own model evaluations; requests that
+        arrive during one of them are answered when it returns. */
+    void build_values_dynamic( const std::vector<unsigned int>& todo,
+                               std::vector<unsigned int>& local_n,
+                               std::vector<std::vector<double> >& local_values,
+                               std::ofstream* checkpoint );
+
+    //! Evaluate the model at global index n and cache the result locally
+    void evaluate_index( unsigned int n, V& domain_vector,
+                         std::vector<double>& values,
+                         std::vector<unsigned int>& local_n,
+                         std::vector<std::vector<double> >& local_values,
+                         std::ofstream* checkpoint );
+
+    //! Answer work queue requests from the other subenvironments
+    /*! Only called on inter0 rank 0. If \c blocking is true, waits for and
+        answers exactly one request; otherwise answers all pending ones. */
+    void serve_work_requests( unsigned int n_chunks, unsigned int& next_chunk,
+                              unsigned int& n_retired, bool blocking );
+
+    //! Read all existing checkpoint files, set their values and flag their indices
+    /*! Must be called on all processes; values are only set on full rank 0
+        and reach the other processes through sync_data(). */
+    void read_checkpoints( std::vector<char>& evaluated );
+
+    //! Open (appending) the checkpoint file of this subenvironment
+    std::ofstream* open_checkpoint() const;
+
+    //! Name of the checkpoint file written by subenvironment sub_id
+    std::string checkpoint_filename( const std::string& sub_id ) const;
+
     //! Helper function to grab representative dataset from m_data
     /*! We only grab the first data set since the environments are guaranteed
       to be consistent by the nature of constructing an InterpolationSurrogateDataSet. */
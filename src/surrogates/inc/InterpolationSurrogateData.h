@@ -52,18 +52,36 @@ namespace QUESO
     const std::vector<unsigned int>& get_n_points() const
     { return this->m_n_points; };
 
+    //! Values stored in this object
+    /*! Not available when values are held externally, see set_external_values(). */
     const std::vector<double>& get_values() const
-    { return this->m_values; };
+    { queso_assert(!this->m_external_values);
+      return this->m_values; };
 
     std::vector<double>& get_values()
-    { return this->m_values; };
+    { queso_assert(!this->m_external_values);
+      return this->m_values; };
 
     double get_value( unsigned int n ) const
-    { queso_assert_less(n,this->m_values.size());
-      return this->m_values[n]; };
+    { queso_assert_less(n,this->m_n_values);
+      return this->m_external_values ? this->m_external_values[n] : this->m_values[n]; };
+
+    //! Contiguous array of all n_values() values, wherever they are stored
+    const double* raw_values() const
+    { return this->m_external_values ? this->m_external_values : &this->m_values[0]; };
 
     unsigned int n_values() const
-    { return this->m_values.size(); };
+    { return this->m_n_values; };
+
+    //! Use read-only values owned by someone else, e.g. a memory-mapped file
+    /*! values must point to n_values() doubles and outlive this object.
+        The internal copy is released, so set_value(), set_values() and
+        sync_values() may no longer be used. */
+    void set_external_values( const double* values );
+
+    //! True if values are held externally
+    bool has_external_values() const
+    { return (this->m_external_values != NULL); };
 
     //! Set all values. Dimension must be consistent with internal m_values.
     /*! This does a full copy of the values vector. This is mainly for testing,
@@ -125,6 +143,12 @@ namespace QUESO
         \todo We currently store all values reside on all processes. Generalization would
               be to partition values across processes allocated for the subenvironment. */
     std::vector<double> m_values;
+
+    //! Number of values, kept separately since m_values may be released
+    unsigned int m_n_values;
+
+    //! Externally owned read-only values; NULL when m_values is used
+    const double* m_external_values;
   };
 
 } // end namespace QUESO
@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef UQ_INTERPOLATION_SURROGATE_IO_BINARY_H
+#define UQ_INTERPOLATION_SURROGATE_IO_BINARY_H
+
+#include <queso/InterpolationSurrogateIOBase.h>
+
+// C++
+#include <cstddef>
+
+namespace QUESO
+{
+  //! Binary reader/writer for interpolation surrogate data
+  /*! The file holds a small header (dimension, domain bounds, n_points)
+      followed by the values as raw native-endian doubles, so reading
+      and writing is a single bulk transfer instead of text parsing.
+
+      When memory mapping is enabled (the default), every process maps the
+      value array read-only instead of reading and broadcasting it. All the
+      processes of a node then share the same page-cache copy and nothing is
+      parsed at startup. The file must stay in place while the data is in use
+      and be visible to every process. */
+  template<class V, class M>
+  class InterpolationSurrogateIOBinary : public InterpolationSurrogateIOBase<V,M>
+  {
+  public:
+
+    InterpolationSurrogateIOBinary( bool use_mmap = true );
+
+    virtual ~InterpolationSurrogateIOBinary();
+
+    //! Read Interpolation surrogate data from filename
+    /*! Without memory mapping, processor reading_rank reads the file and
+        broadcasts it, as InterpolationSurrogateIOASCII does. With memory
+        mapping, each processor maps the file itself and reading_rank is
+        unused. */
+    virtual void read( const std::string& filename,
+                       const FullEnvironment& env,
+                       const std::string& vector_space_prefix,
+                       int reading_rank = 0 );
+
+    //! Write interpolation surrogate data to filename using processor writing_rank
+    /*! env.fullRank() must contain writing_rank. By default processor 0
+        writes the data. */
+    virtual void write( const std::string& filename,
+                        const InterpolationSurrogateData<V,M>& data,
+                        int writing_rank = 0 ) const;
+
+  protected:
+
+    //! Parse the header and set up vector space, domain and data objects
+    /*! header must point to the start of the file contents. Returns the
+        byte offset at which the values start. */
+    std::size_t setup_from_header( const char* header,
+                                   std::size_t header_size,
+                                   const FullEnvironment& env,
+                                   const std::string& vector_space_prefix,
+                                   const std::string& filename );
+
+    //! Size in bytes of the header for a given dimension
+    static std::size_t header_size( unsigned int dim );
+
+    //! Release the current mapping, if any
+    void unmap();
+
+    bool m_use_mmap;
+
+    //! Start of the mapped file, NULL if nothing is mapped
+    void* m_mapped;
+
+    //! Length of the mapping in bytes
+    std::size_t m_mapped_size;
+
+  private:
+
+    //! Mappings may not be shared between objects
+    InterpolationSurrogateIOBinary( const InterpolationSurrogateIOBinary& );
+    InterpolationSurrogateIOBinary& operator=( const InterpolationSurrogateIOBinary& );
+
+  };
+} // end namespace QUESO
+
+#endif // UQ_INTERPOLATION_SURROGATE_IO_BINARY_H
@@ -0,0 +1,75 @@
+//-----------------------------------------------------------------------bl-
+//--------------------------------------------------------------------------
+//
+// QUESO - a library to support the Quantification of Uncertainty
+// for Estimation, Simulation and Optimization
+//
+// Copyright (C) 2008-2017 The PECOS Development Team
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the Version 2.1 GNU Lesser General
+// Public License as published by the Free Software Foundation.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc. 51 Franklin Street, Fifth Floor,
+// Boston, MA  02110-1301  USA
+//
+//-----------------------------------------------------------------------el-
+
+#ifndef QUESO_TEST_GAUSSIAN_LIKELIHOOD_H
+#define QUESO_TEST_GAUSSIAN_LIKELIHOOD_H
+
+#include <queso/GslVector.h>
+#include <queso/GslMatrix.h>
+#include <queso/VectorSet.h>
+#include <queso/ScalarFunction.h>
+
+#include <cmath>
+
+// Two-dimensional Gaussian log-likelihood with correlated components and
+// mode (mean1, mean2), shared by the sampler tests
+template <class V = QUESO::GslVector, class M = QUESO::GslMatrix>
+class CorrelatedGaussianLikelihood : public QUESO::BaseScalarFunction<V, M>
+{
+public:
+  CorrelatedGaussianLikelihood(const char * prefix,
+      const QUESO::VectorSet<V, M> & domain, double mean1, double mean2)
+    : QUESO::BaseScalarFunction<V, M>(prefix, domain),
+      m_mean1(mean1),
+      m_mean2(mean2)
+  {
+  }
+
+  virtual ~CorrelatedGaussianLikelihood()
+  {
+  }
+
+  virtual double lnValue(const V & domainVector, const V * /* domainDirection */,
+      V * /* gradVector */, M * /* hessianMatrix */, V * /* hessianEffect */) const
+  {
+    double x1 = domainVector[0] - m_mean1;
+    double x2 = domainVector[1] - m_mean2;
+    return -0.5 * (x1 * x1 + x2 * x2 + x1 * x2);
+  }
+
+  virtual double actualValue(const V & domainVector, const V * domainDirection,
+      V * gradVector, M * hessianMatrix, V * hessianEffect) const
+  {
+    return std::exp(this->lnValue(domainVector, domainDirection, gradVector,
+          hessianMatrix, hessianEffect));
+  }
+
+  using QUESO::BaseScalarFunction<V, M>::lnValue;
+
+private:
+  double m_mean1;
+  double m_mean2;
+};
+
+#endif // QUESO_TEST_GAUSSIAN_LIKELIHOOD_H
@@ -0,0 +1,19 @@
+#!/bin/bash
+set -eu
+set -o pipefail
+
+if grep "QUESO_HAVE_MPI 1" ../config_queso.h 2>&1 >/dev/null; then
+  rm -f output_test_ensemble_nprocs_[123].txt
+
+  for np in 1 2 3; do
+    mpirun -np $np ../libtool --mode=execute ./test_ensemble_nprocs \
+      output_test_ensemble_nprocs_$np.txt
+  done
+
+  diff output_test_ensemble_nprocs_1.txt output_test_ensemble_nprocs_2.txt
+  diff output_test_ensemble_nprocs_1.txt output_test_ensemble_nprocs_3.txt
+
+  rm -f output_test_ensemble_nprocs_[123].txt
+else
+  exit 77
+fi
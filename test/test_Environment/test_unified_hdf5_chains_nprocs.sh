@@ -0,0 +1,15 @@
+#!/bin/bash
+set -eu
+set -o pipefail
+
+if grep "QUESO_HAVE_MPI 1" ../config_queso.h 2>&1 >/dev/null &&
+   grep "QUESO_HAVE_HDF5 1" ../config_queso.h 2>&1 >/dev/null; then
+  rm -rf output_test_unified_hdf5_chains
+
+  # Three subenvironments, with chains of 2, 3 and 4 positions
+  mpirun -np 3 ../libtool --mode=execute ./test_unified_hdf5_chains
+
+  rm -rf output_test_unified_hdf5_chains
+else
+  exit 77
+fi
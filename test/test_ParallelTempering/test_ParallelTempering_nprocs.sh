@@ -0,0 +1,11 @@
+#!/bin/bash
+set -eu
+set -o pipefail
+
+# Four chains, one per subenvironment, so that the swaps between
+# neighbouring temperatures and the ladder adaptation are exercised
+if grep "QUESO_HAVE_MPI 1" ../config_queso.h 2>&1 >/dev/null; then
+  mpirun -np 4 ../libtool --mode=execute ./test_ParallelTempering
+else
+  exit 77
+fi